@@ -0,0 +1,103 @@
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "ecs.hpp"
+#include "renderPipeline.hpp"
+
+// bench sin ventana del pipeline simulación/render: la simulación ocupa CPU por SIMULATION_TIME
+// y el consumo bloquea por CONSUME_TIME (como esperar vsync/GPU), con solapamiento
+// el tiempo total se acerca al mayor de ambos en vez de a su suma
+
+struct PositionComponent
+{
+    float x, y;
+};
+
+struct VelocityComponent
+{
+    float velocity_x, velocity_y;
+};
+
+struct BenchInstance
+{
+    float x, y;
+};
+
+const uint32_t ENTITY_COUNT = 4000;
+const uint32_t FRAME_COUNT = 300;
+const auto SIMULATION_TIME = std::chrono::microseconds(2000);
+const auto CONSUME_TIME = std::chrono::microseconds(2000);
+
+// espera activa para simular trabajo de CPU con duración fija
+void busy_wait(std::chrono::microseconds duration)
+{
+    auto end_time = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end_time) {}
+}
+
+void simulate(ECS &ecs, float delta_time)
+{
+    for (auto& position_slot : ecs.get_component_dense_vector<PositionComponent>())
+    {
+        VelocityComponent& velocity = ecs.get_component<VelocityComponent>(position_slot.entity_id);
+        position_slot.component.x += velocity.velocity_x * delta_time;
+        position_slot.component.y += velocity.velocity_y * delta_time;
+    }
+}
+
+void extract(ECS &ecs, std::vector<BenchInstance> &instances)
+{
+    for (auto& position_slot : ecs.get_component_dense_vector<PositionComponent>())
+    {
+        instances.push_back({ position_slot.component.x, position_slot.component.y });
+    }
+}
+
+int main()
+{
+    ECS ecs;
+    ecs.register_component<PositionComponent>();
+    ecs.register_component<VelocityComponent>();
+
+    for (uint32_t i = 0; i < ENTITY_COUNT; i++)
+    {
+        EntityId entity_id = ecs.create_entity();
+        ecs.add_component<PositionComponent>(entity_id) = { (float) i, 0.0f };
+        ecs.add_component<VelocityComponent>(entity_id) = { 1.0f, 2.0f };
+    }
+
+    RenderExtractionBuffer<BenchInstance> render_buffer;
+    uint64_t consumed_instances = 0;
+    {
+        HeadlessRenderConsumer<BenchInstance> consumer(render_buffer, [&consumed_instances](const std::vector<BenchInstance> &instances)
+        {
+            consumed_instances += instances.size();
+            std::this_thread::sleep_for(CONSUME_TIME);
+        });
+
+        for (uint32_t frame = 0; frame < FRAME_COUNT; frame++)
+        {
+            simulate(ecs, 1.0f / 60.0f);
+            busy_wait(SIMULATION_TIME);
+            render_buffer.extract(ecs, extract);
+        }
+
+        // se espera a que el consumidor tome el último frame antes de detener el pipeline
+        while (render_buffer.get_stats().frames_consumed + 1 < FRAME_COUNT) std::this_thread::yield();
+    }
+
+    RenderPipelineStats stats = render_buffer.get_stats();
+    double serial_us = FRAME_COUNT * double((SIMULATION_TIME + CONSUME_TIME).count());
+    std::printf("frames publicados: %llu, consumidos: %llu, instancias: %llu\n",
+                (unsigned long long) stats.frames_published, (unsigned long long) stats.frames_consumed,
+                (unsigned long long) consumed_instances);
+    std::printf("tiempo total: %llu us (serial estimado: %.0f us)\n", (unsigned long long) stats.elapsed_us, serial_us);
+    std::printf("espera productor: %llu us, espera consumidor: %llu us\n",
+                (unsigned long long) stats.producer_wait_us, (unsigned long long) stats.consumer_wait_us);
+    std::printf("solapamiento: %llu us (%.1f%% del tiempo total)\n", (unsigned long long) stats.get_overlap_us(),
+                stats.elapsed_us ? 100.0 * stats.get_overlap_us() / stats.elapsed_us : 0.0);
+
+    return 0;
+}
@@ -0,0 +1,163 @@
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "ecs.hpp"
+
+// chequeo sin ventana de equidad del time-slicing: se registra en qué llamada se procesa cada entidad
+// y se mide el periodo (llamadas entre dos procesamientos seguidos). con fraction f ninguna entidad
+// debe esperar más de ceil(1 / f) llamadas, ni procesarse dos veces en una misma llamada
+
+struct SlicedComponent
+{
+    uint32_t value;
+};
+
+const uint32_t CALL_COUNT = 60;
+
+struct SliceTracker
+{
+    std::vector<int> last_call = std::vector<int>(MAX_ENTITIES, -1);
+    std::vector<uint32_t> max_period = std::vector<uint32_t>(MAX_ENTITIES, 0);
+    std::vector<uint32_t> visit_count = std::vector<uint32_t>(MAX_ENTITIES, 0);
+    uint32_t repeated_count = 0; // -> entidades procesadas dos veces en una misma llamada
+
+    void visit(EntityId entity_id, int call)
+    {
+        if (last_call[entity_id] == call) repeated_count++;
+        else if (last_call[entity_id] >= 0 && uint32_t(call - last_call[entity_id]) > max_period[entity_id])
+        {
+            max_period[entity_id] = call - last_call[entity_id];
+        }
+        last_call[entity_id] = call;
+        visit_count[entity_id]++;
+    }
+
+    // se reporta el peor periodo entre las entidades dadas, true si respeta el límite
+    bool report(const char *name, const std::vector<EntityId> &entities, float fraction, int call_count)
+    {
+        uint32_t limit = static_cast<uint32_t>(std::ceil(1.0f / fraction));
+        uint32_t worst_period = 0;
+        for (EntityId entity_id : entities)
+        {
+            // la espera desde el último procesamiento hasta el final también cuenta
+            uint32_t tail_period = last_call[entity_id] < 0 ? call_count : call_count - last_call[entity_id] - 1;
+            uint32_t period = std::max(max_period[entity_id], tail_period);
+            if (period > worst_period) worst_period = period;
+        }
+
+        bool ok = worst_period <= limit && repeated_count == 0;
+        std::printf("%s: periodo máx. %u (límite %u), repetidas en una llamada: %u => %s\n",
+                    name, worst_period, limit, repeated_count, ok ? "ok" : "FALLA");
+        return ok;
+    }
+};
+
+// pool estable: todas las entidades se procesan exactamente una vez cada ceil(1 / f) llamadas o menos
+bool check_stable(uint32_t entity_count, float fraction)
+{
+    ECS ecs;
+    ecs.register_component<SlicedComponent>();
+
+    std::vector<EntityId> entities;
+    for (uint32_t i = 0; i < entity_count; i++)
+    {
+        entities.push_back(ecs.create_entity());
+        ecs.add_component<SlicedComponent>(entities.back());
+    }
+
+    SliceTracker tracker;
+    for (int call = 0; call < int(CALL_COUNT); call++)
+    {
+        ecs.update_sliced<SlicedComponent>(fraction, [&](DenseSlot<SlicedComponent> &slot) { tracker.visit(slot.entity_id, call); });
+    }
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "estable (%u entidades, f = %.2f)", entity_count, fraction);
+    return tracker.report(name, entities, fraction, CALL_COUNT);
+}
+
+// cada removal_interval llamadas la función destruye una entidad (alternando una ya procesada y una pendiente),
+// se mide el periodo de las entidades que sobreviven todo el chequeo.
+// NOTE: la ventana es ceil(tamaño * f) del pool actual, por lo que remover en cada llamada achica la ventana
+// más rápido que el trabajo pendiente de la vuelta y puede alargar el periodo en una llamada
+bool check_removals(uint32_t entity_count, float fraction, int removal_interval)
+{
+    ECS ecs;
+    ecs.register_component<SlicedComponent>();
+
+    std::vector<EntityId> victims; // -> entidades que se pueden destruir
+    std::vector<EntityId> survivors;
+    for (uint32_t i = 0; i < entity_count; i++)
+    {
+        EntityId entity_id = ecs.create_entity();
+        ecs.add_component<SlicedComponent>(entity_id);
+        if (i % 2 == 0) victims.push_back(entity_id);
+        else survivors.push_back(entity_id);
+    }
+
+    SliceTracker tracker;
+    int call_count = 0;
+    for (int call = 0; call < int(CALL_COUNT); call++)
+    {
+        bool removed = call % removal_interval != 0; // -> solo se remueve en llamadas múltiplo del intervalo
+        if (victims.empty()) break;
+        ecs.update_sliced<SlicedComponent>(fraction, [&](DenseSlot<SlicedComponent> &slot)
+        {
+            tracker.visit(slot.entity_id, call);
+            if (removed || victims.empty()) return;
+
+            // se destruye una víctima procesada (zona detrás del cursor) o pendiente, según la llamada
+            bool processed_victim = (call / removal_interval) % 2 == 0;
+            EntityId victim = processed_victim ? victims.front() : victims.back();
+            victims.erase(processed_victim ? victims.begin() : victims.end() - 1);
+            if (victim == slot.entity_id) return;
+            ecs.destroy_entity(victim);
+            removed = true;
+        });
+        call_count++;
+    }
+
+    char name[96];
+    std::snprintf(name, sizeof(name), "con remociones (%u entidades, f = %.2f, cada %d llamadas)", entity_count, fraction, removal_interval);
+    return tracker.report(name, survivors, fraction, call_count);
+}
+
+// pool de jerarquía re-ordenado por profundidad cada llamada: ninguna entidad queda sin procesar.
+// el orden cambia entre vueltas, por lo que el límite es de dos vueltas en vez de una
+bool check_hierarchy_sort(uint32_t entity_count, float fraction)
+{
+    ECS ecs;
+    std::vector<EntityId> entities;
+    for (uint32_t i = 0; i < entity_count; i++) entities.push_back(ecs.create_entity());
+    for (uint32_t i = 1; i < entity_count; i++) ecs.set_parent(entities[i], entities[0]);
+
+    SliceTracker tracker;
+    for (int call = 0; call < int(CALL_COUNT); call++)
+    {
+        // se mueve un hijo entre la raíz y el último hijo (cambia su profundidad y el orden del pool)
+        EntityId child_id = entities[1 + call % (entity_count - 2)];
+        ecs.set_parent(child_id, call % 2 == 0 ? entities[entity_count - 1] : entities[0]);
+        ecs.get_hierarchy_dense_vector();
+
+        ecs.update_sliced<HierarchyComponent>(fraction, [&](DenseSlot<HierarchyComponent> &slot) { tracker.visit(slot.entity_id, call); });
+    }
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "jerarquía re-ordenada (%u entidades, f = %.2f)", entity_count, fraction);
+    return tracker.report(name, entities, fraction / 2.0f, CALL_COUNT);
+}
+
+int main()
+{
+    bool ok = true;
+    ok &= check_stable(10, 0.3f);
+    ok &= check_stable(10, 0.25f);
+    ok &= check_stable(97, 0.1f);
+    ok &= check_removals(50, 0.2f, 4);
+    ok &= check_removals(120, 0.25f, 2);
+    ok &= check_hierarchy_sort(8, 0.25f);
+    ok &= check_hierarchy_sort(64, 0.2f);
+
+    return ok ? 0 : 1;
+}
@@ -2,6 +2,10 @@
 
 #include <raylib.h>
 
+#include "types.hpp"
+
+using namespace ecs_types;
+
 struct TransformComponent
 {
     float x, y;
@@ -26,3 +30,17 @@ struct LifeTimeComponent
     float max;
     float remaining;
 };
+
+// -- eventos --
+struct LifeTimeExpiredEvent
+{
+    EntityId entity_id;
+};
+
+// datos de render extraídos por frame (instancia contigua en el buffer de extracción)
+struct RenderInstance
+{
+    float x, y;
+    float radius;
+    Color color;
+};
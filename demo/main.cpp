@@ -1,9 +1,24 @@
 #include <raylib.h>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <random>
+#include <thread>
 
 #include "components.hpp"
 #include "systems.hpp"
+#include "renderPipeline.hpp"
 
-void spawn_particles(ECS &ecs, float spawn_rate, float delta_time)
+// NOTE: raylib no es thread-safe, por lo que el hilo de simulación usa su propio generador
+// (en vez de GetRandomValue) y recibe el tamaño de pantalla leído desde el hilo principal
+std::mt19937 random_engine((unsigned int) time(NULL));
+
+int random_value(int min, int max)
+{
+    return std::uniform_int_distribution<int>(min, max)(random_engine);
+}
+
+void spawn_particles(World &ecs, float spawn_rate, float delta_time, int screen_width)
 {
     static float spawn_timer = 0.0f;
     spawn_timer += delta_time;
@@ -14,7 +29,7 @@ void spawn_particles(ECS &ecs, float spawn_rate, float delta_time)
     // se crea nueva entidad y se inicializan componentes
     EntityId new_entity = ecs.create_entity();
     Vector2 spawn_position = {
-        (float) GetRandomValue(0, GetScreenWidth()),
+        (float) random_value(0, screen_width),
         -10.0f
     };
 
@@ -27,16 +42,16 @@ void spawn_particles(ECS &ecs, float spawn_rate, float delta_time)
     };
     
     PhysicsComponent physics_component = {
-        (float) GetRandomValue(-100, 100),
-        (float) GetRandomValue(100, 250),
+        (float) random_value(-100, 100),
+        (float) random_value(100, 250),
         1.0f
     };
 
     TextureComponent texture_component = {
         (Color){
-            (unsigned char) GetRandomValue(0, 255),
-            (unsigned char) GetRandomValue(0, 255),
-            (unsigned char) GetRandomValue(0, 255),
+            (unsigned char) random_value(0, 255),
+            (unsigned char) random_value(0, 255),
+            (unsigned char) random_value(0, 255),
             255
         },
         30.0f,
@@ -59,27 +74,56 @@ void spawn_particles(ECS &ecs, float spawn_rate, float delta_time)
 int main()
 {
     InitWindow(1280, 720, "ECS Demo");
-    SetRandomSeed(time(NULL));
     SetTargetFPS(60);
 
     // -- setup ECS --
-    ECS ecs = ECS();
+    World ecs;
     ecs.register_component<TransformComponent>();
     ecs.register_component<PhysicsComponent>();
     ecs.register_component<TextureComponent>();
     ecs.register_component<LifeTimeComponent>();
+    ecs.register_event<LifeTimeExpiredEvent>();
+
+    // -- simulación --
+    // corre en su propio hilo: mientras se dibuja el frame N se simula el N+1,
+    // al final de cada frame se extraen los datos de render al doble buffer
+    RenderExtractionBuffer<RenderInstance> render_buffer;
+    std::atomic<bool> running = true;
+
+    // tamaño de pantalla se lee en el hilo principal (raylib) y se comparte con la simulación
+    std::atomic<int> screen_width = GetScreenWidth();
+    std::atomic<int> screen_height = GetScreenHeight();
+
+    std::thread simulation_thread([&ecs, &render_buffer, &running, &screen_width, &screen_height]()
+    {
+        auto last_time = std::chrono::steady_clock::now();
+        while (running.load())
+        {
+            auto now = std::chrono::steady_clock::now();
+            float delta_time = std::chrono::duration<float>(now - last_time).count();
+            last_time = now;
 
-    // -- game loop --
+            spawn_particles(ecs, 0.0f, delta_time, screen_width.load());
+            MovementSystem::move(ecs, delta_time);
+            LifeTimeSystem::update(ecs, delta_time);
+            BoundsCollisionSystem::handle_collisions(ecs, screen_width.load(), screen_height.load());
+
+            // eventos enviados en este frame pasan a ser legibles
+            ecs.update_events();
+            LifeTimeSystem::destroy_expired(ecs);
+
+            if (!render_buffer.extract(ecs, RenderSystem::extract)) break;
+        }
+    });
+
+    // -- render loop --
     while (!WindowShouldClose())
     {
-        // update
-        float delta_time = GetFrameTime();
-        spawn_particles(ecs, 0.0f, delta_time);
-        MovementSystem::move(ecs, delta_time);
-        LifeTimeSystem::update(ecs, delta_time);
-        BoundsCollisionSystem::handle_collisions(ecs);
-
-        // render
+        screen_width = GetScreenWidth();
+        screen_height = GetScreenHeight();
+
+        const std::vector<RenderInstance>* instances = render_buffer.acquire();
+
         BeginDrawing();
         {
             ClearBackground(BLACK);
@@ -87,11 +131,17 @@ int main()
             const char* fps_message = TextFormat("FPS: %d", GetFPS());
             DrawText(fps_message, 10, 10, 20, RAYWHITE);
 
-            RenderSystem::render(ecs);
+            if (instances != nullptr) RenderSystem::render(*instances);
             
         }
         EndDrawing();
+
+        render_buffer.release();
     }
 
+    running = false;
+    render_buffer.stop();
+    simulation_thread.join();
+
     return 0;
 }
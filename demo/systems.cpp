@@ -8,7 +8,7 @@
 // NOTE: cada sistema itera sobre el conjunto denso de uno de los componentes que necesite (el más pequeño)
 // y así se asegura minimizar número de iteraciones
 
-void MovementSystem::move(ECS &ecs, float delta_time)
+void MovementSystem::move(World &ecs, float delta_time)
 {
     auto& transform_dense_vector = ecs.get_component_dense_vector<TransformComponent>();
     auto& physics_dense_vector = ecs.get_component_dense_vector<PhysicsComponent>();
@@ -57,7 +57,7 @@ void MovementSystem::move(ECS &ecs, float delta_time)
 
 }
 
-void RenderSystem::render(ECS &ecs)
+void RenderSystem::extract(World &ecs, std::vector<RenderInstance> &instances)
 {
     auto& transform_dense_vector = ecs.get_component_dense_vector<TransformComponent>();
     auto& texture_dense_vector = ecs.get_component_dense_vector<TextureComponent>();
@@ -73,7 +73,7 @@ void RenderSystem::render(ECS &ecs)
             TextureComponent& texture = ecs.get_component<TextureComponent>(entity_id);
             
             Color color = { texture.color.r, texture.color.g, texture.color.b, (unsigned char) texture.alpha };
-            DrawCircleV({ transform.x, transform.y }, texture.width / 2, color);
+            instances.push_back({ transform.x, transform.y, texture.width / 2, color });
         }
     }
     else
@@ -87,18 +87,26 @@ void RenderSystem::render(ECS &ecs)
             TransformComponent& transform = ecs.get_component<TransformComponent>(entity_id);
             Color color = { texture.color.r, texture.color.g, texture.color.b, (unsigned char) texture.alpha };
             
-            DrawCircleV({ transform.x, transform.y }, texture.width / 2, color);
+            instances.push_back({ transform.x, transform.y, texture.width / 2, color });
             
         }
     }
 
 }
 
-void LifeTimeSystem::update(ECS &ecs, float delta_time)
+void RenderSystem::render(const std::vector<RenderInstance> &instances)
+{
+    for (const RenderInstance& instance : instances)
+    {
+        DrawCircleV({ instance.x, instance.y }, instance.radius, instance.color);
+    }
+}
+
+void LifeTimeSystem::update(World &ecs, float delta_time)
 {
     auto& life_time_dense_vector = ecs.get_component_dense_vector<LifeTimeComponent>();
+    auto& expired_events = ecs.get_event_queue<LifeTimeExpiredEvent>();
 
-    std::vector<EntityId> entities_to_destroy;
     for (auto& life_time_slot : life_time_dense_vector)
     {
         EntityId entity_id = life_time_slot.entity_id;
@@ -116,20 +124,24 @@ void LifeTimeSystem::update(ECS &ecs, float delta_time)
 
         if (life_time.remaining <= 0.0f)
         {
-            entities_to_destroy.push_back(entity_id);
+            expired_events.send({ entity_id });
         }
 
     }
 
+}
+
+void LifeTimeSystem::destroy_expired(World &ecs)
+{
     // se destruyen entidades sin tiempo de vida restante
-    for (EntityId entity_id : entities_to_destroy)
+    // (no se puede destruir mientras se itera el pool en update)
+    ecs.read_events<LifeTimeExpiredEvent>([&ecs](const LifeTimeExpiredEvent &event)
     {
-        ecs.destroy_entity(entity_id);
-    }
-
+        ecs.destroy_entity(event.entity_id);
+    });
 }
 
-void BoundsCollisionSystem::handle_collisions(ECS &ecs)
+void BoundsCollisionSystem::handle_collisions(World &ecs, int screen_width, int screen_height)
 {
     // idea es detectar colisiones con bordes de pantalla y hacer rebotes
     auto& transform_dense_vector = ecs.get_component_dense_vector<TransformComponent>();
@@ -145,9 +157,9 @@ void BoundsCollisionSystem::handle_collisions(ECS &ecs)
             TransformComponent& transform = transform_slot.component;
             PhysicsComponent& physics = ecs.get_component<PhysicsComponent>(entity_id);
             
-            if (transform.y > GetScreenHeight())
+            if (transform.y > screen_height)
             {
-                transform.y = GetScreenHeight();
+                transform.y = screen_height;
                 physics.velocity_y *= -0.6f; // -> pierde 'energía' en cada rebote
             }
 
@@ -157,9 +169,9 @@ void BoundsCollisionSystem::handle_collisions(ECS &ecs)
                 physics.velocity_x *= -0.6f;
             }
 
-            if (transform.x > GetScreenWidth())
+            if (transform.x > screen_width)
             {
-                transform.x = GetScreenWidth();
+                transform.x = screen_width;
                 physics.velocity_x *= -0.6f;
             }
 
@@ -175,9 +187,9 @@ void BoundsCollisionSystem::handle_collisions(ECS &ecs)
             PhysicsComponent& physics = physics_slot.component;
             TransformComponent& transform = ecs.get_component<TransformComponent>(entity_id);
             
-            if (transform.y > GetScreenHeight())
+            if (transform.y > screen_height)
             {
-                transform.y = GetScreenHeight();
+                transform.y = screen_height;
                 physics.velocity_y *= -0.6f; // -> pierde 'energía' en cada rebote
             }
 
@@ -187,9 +199,9 @@ void BoundsCollisionSystem::handle_collisions(ECS &ecs)
                 physics.velocity_x *= -0.6f;
             }
 
-            if (transform.x > GetScreenWidth())
+            if (transform.x > screen_width)
             {
-                transform.x = GetScreenWidth();
+                transform.x = screen_width;
                 physics.velocity_x *= -0.6f;
             }
         }
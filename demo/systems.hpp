@@ -1,24 +1,36 @@
 #pragma once
 
 #include "../include/ecs.hpp"
+#include "../include/staticWorld.hpp"
+#include "components.hpp"
+
+// se elige el tipo de mundo en compilación (make ECS_STATIC_WORLD=1 para usar StaticWorld)
+#ifdef ECS_STATIC_WORLD
+using World = StaticWorld<TransformComponent, PhysicsComponent, TextureComponent, LifeTimeComponent>;
+#else
+using World = ECS;
+#endif
 
 namespace MovementSystem
 {
-    void move(ECS &ecs, float delta_time);
+    void move(World &ecs, float delta_time);
 
 }
 
 namespace RenderSystem
 {
-    void render(ECS &ecs);
+    // se copian solo datos de render (posición, color, tamaño) al buffer de instancias
+    void extract(World &ecs, std::vector<RenderInstance> &instances);
+    void render(const std::vector<RenderInstance> &instances);
 }
 
 namespace LifeTimeSystem
 {
-    void update(ECS &ecs, float delta_time);
+    void update(World &ecs, float delta_time); // -> envía LifeTimeExpiredEvent
+    void destroy_expired(World &ecs); // -> consume LifeTimeExpiredEvent
 }
 
 namespace BoundsCollisionSystem
 {
-    void handle_collisions(ECS &ecs);
+    void handle_collisions(World &ecs, int screen_width, int screen_height);
 }
@@ -1,10 +1,13 @@
 #pragma once
 
+#include <atomic>
 #include <unordered_map>
 #include <memory>
 #include <cassert>
+#include <type_traits>
 
 #include "componentPool.hpp"
+#include "sharedComponentPool.hpp"
 #include "types.hpp"
 
 using namespace ecs_types;
@@ -16,7 +19,11 @@ class ComponentManager
     private:
         ComponentPools m_component_pools; // -> mapea type ids a sus components pools
         
-        ComponentTypeId m_next_component_type_id = 0; // -> id único para siguiente tipo de componente a registrar
+        // id único para siguiente tipo de componente, global al proceso: los type ids se guardan en statics
+        // compartidos por todos los mundos, así un tipo tiene el mismo id en cada ECS aunque se registren en distinto orden
+        inline static std::atomic<ComponentTypeId> s_next_component_type_id{0};
+
+        Signature m_shared_component_types; // -> bit en 1 para type ids registrados como compartidos (su pool es SharedComponentPool)
 
 
     public:
@@ -28,7 +35,14 @@ class ComponentManager
         {
             ComponentTypeId type_id = get_component_type_id<Component>();
             assert(m_component_pools.find(type_id) == m_component_pools.end() && "Componente ya registrado");
-            assert(m_next_component_type_id < MAX_COMPONENTS && "Límite de tipos de componentes alcanzado");
+            assert(type_id < MAX_COMPONENTS && "Límite de tipos de componentes alcanzado");
+
+            if constexpr (std::is_empty_v<Component>)
+            {
+                // tags (tipos vacíos) solo viven como bit en la signature, no tienen pool
+                m_component_pools.emplace(type_id, nullptr);
+                return;
+            }
 
             // se crea un nuevo component pool y se agrega al map
             std::unique_ptr<IComponentPool> new_pool = std::make_unique<ComponentPool<Component>>();
@@ -36,21 +50,53 @@ class ComponentManager
             
         }
 
+        template <typename Component>
+        void register_shared_component()
+        {
+            ComponentTypeId type_id = get_component_type_id<Component>();
+            assert(m_component_pools.find(type_id) == m_component_pools.end() && "Componente ya registrado");
+            assert(type_id < MAX_COMPONENTS && "Límite de tipos de componentes alcanzado");
+
+            // componentes compartidos usan su propio pool (valores deduplicados), bajo el mismo type id
+            std::unique_ptr<IComponentPool> new_pool = std::make_unique<SharedComponentPool<Component>>();
+            m_component_pools.emplace(type_id, std::move(new_pool));
+            m_shared_component_types.set(type_id);
+        }
+
+        template <typename Component>
+        SharedComponentPool<Component>& get_shared_component_pool()
+        {
+            ComponentTypeId type_id = get_component_type_id<Component>();
+            assert(m_component_pools.find(type_id) != m_component_pools.end() && "Componente no registrado");
+
+            IComponentPool *base_pool = m_component_pools[type_id].get();
+            assert(m_shared_component_types.test(type_id) && "Componente no registrado como compartido");
+            return *static_cast<SharedComponentPool<Component>*>(base_pool);
+        }
+
         template <typename Component>
         ComponentTypeId get_component_type_id()
         {
             // static permite que type id se asigne una única vez por tipo de componente
-            static ComponentTypeId type_id = m_next_component_type_id++; // -> se asigna y luego se incrementa (si es que no se ha asignado antes)
+            static ComponentTypeId type_id = s_next_component_type_id.fetch_add(1, std::memory_order_relaxed); // -> se asigna una vez y se incrementa el contador global
             return type_id;
         }
 
+        template <typename Component>
+        bool is_component_registered()
+        {
+            return m_component_pools.find(get_component_type_id<Component>()) != m_component_pools.end();
+        }
+
         template <typename Component>
         void add_component(EntityId entity_id)
         {
+            static_assert(!std::is_empty_v<Component>, "Tags no tienen pool, se manejan mediante la signature");
             assert(entity_id < MAX_ENTITIES && "Entidad no válida");
 
             ComponentTypeId type_id = get_component_type_id<Component>();
             assert(m_component_pools.find(type_id) != m_component_pools.end() && "Componente no registrado");
+            assert(!m_shared_component_types.test(type_id) && "Componente compartido, usar API de componentes compartidos");
             
             IComponentPool *base_pool = m_component_pools[type_id].get();
             ComponentPool<Component> *pool = static_cast<ComponentPool<Component>*>(base_pool); // se castea al tipo específico de pool
@@ -60,10 +106,12 @@ class ComponentManager
         template <typename Component>
         void remove_component(EntityId entity_id)
         {
+            static_assert(!std::is_empty_v<Component>, "Tags no tienen pool, se manejan mediante la signature");
             assert(entity_id < MAX_ENTITIES && "Entidad no válida");
 
             ComponentTypeId type_id = get_component_type_id<Component>();
             assert(m_component_pools.find(type_id) != m_component_pools.end() && "Componente no registrado");
+            assert(!m_shared_component_types.test(type_id) && "Componente compartido, usar API de componentes compartidos");
 
             IComponentPool *base_pool = m_component_pools[type_id].get();
             ComponentPool<Component> *pool = static_cast<ComponentPool<Component>*>(base_pool);
@@ -77,16 +125,19 @@ class ComponentManager
             assert(m_component_pools.find(type_id) != m_component_pools.end() && "Componente no registrado");
         
             IComponentPool *base_pool = m_component_pools[type_id].get();
+            if (base_pool == nullptr) return; // -> tag, no hay nada que remover fuera de la signature
             base_pool->remove_component(entity_id);
         }
 
         template <typename Component>
         Component& get_component(EntityId entity_id)
         {
+            static_assert(!std::is_empty_v<Component>, "Tags no tienen pool, se manejan mediante la signature");
             assert(entity_id < MAX_ENTITIES && "Entidad no válida");
 
             ComponentTypeId type_id = get_component_type_id<Component>();
             assert(m_component_pools.find(type_id) != m_component_pools.end() && "Componente no registrado");
+            assert(!m_shared_component_types.test(type_id) && "Componente compartido, usar API de componentes compartidos");
             
             IComponentPool *base_pool = m_component_pools[type_id].get();
             ComponentPool<Component> *pool = static_cast<ComponentPool<Component>*>(base_pool);
@@ -98,10 +149,12 @@ class ComponentManager
         template <typename Component>
         bool has_component(EntityId entity_id)
         {
+            static_assert(!std::is_empty_v<Component>, "Tags no tienen pool, se manejan mediante la signature");
             assert(entity_id < MAX_ENTITIES && "Entidad no válida");
 
             ComponentTypeId type_id = get_component_type_id<Component>();
             assert(m_component_pools.find(type_id) != m_component_pools.end() && "Componente no registrado");
+            assert(!m_shared_component_types.test(type_id) && "Componente compartido, usar API de componentes compartidos");
         
             
             IComponentPool *base_pool = m_component_pools[type_id].get();
@@ -113,12 +166,39 @@ class ComponentManager
         template <typename Component>
         std::vector<DenseSlot<Component>>& get_component_dense_vector()
         {
+            static_assert(!std::is_empty_v<Component>, "Tags no tienen pool, se manejan mediante la signature");
             ComponentTypeId type_id = get_component_type_id<Component>();
             assert(m_component_pools.find(type_id) != m_component_pools.end() && "Componente no registrado");
+            assert(!m_shared_component_types.test(type_id) && "Componente compartido, usar API de componentes compartidos");
 
             IComponentPool *base_pool = m_component_pools[type_id].get();
             ComponentPool<Component> *pool = static_cast<ComponentPool<Component>*>(base_pool);
             return pool->get_dense_vector();
         }
 
+        template <typename Component>
+        ComponentPool<Component>& get_component_pool()
+        {
+            static_assert(!std::is_empty_v<Component>, "Tags no tienen pool, se manejan mediante la signature");
+            ComponentTypeId type_id = get_component_type_id<Component>();
+            assert(m_component_pools.find(type_id) != m_component_pools.end() && "Componente no registrado");
+            assert(!m_shared_component_types.test(type_id) && "Componente compartido, usar API de componentes compartidos");
+
+            IComponentPool *base_pool = m_component_pools[type_id].get();
+            return *static_cast<ComponentPool<Component>*>(base_pool);
+        }
+
+        template <typename Component, typename Compare>
+        void sort_components(Compare compare)
+        {
+            static_assert(!std::is_empty_v<Component>, "Tags no tienen pool, se manejan mediante la signature");
+            ComponentTypeId type_id = get_component_type_id<Component>();
+            assert(m_component_pools.find(type_id) != m_component_pools.end() && "Componente no registrado");
+            assert(!m_shared_component_types.test(type_id) && "Componente compartido, usar API de componentes compartidos");
+
+            IComponentPool *base_pool = m_component_pools[type_id].get();
+            ComponentPool<Component> *pool = static_cast<ComponentPool<Component>*>(base_pool);
+            pool->sort(compare);
+        }
+
 };
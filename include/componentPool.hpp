@@ -2,6 +2,8 @@
 
 #include <vector>
 #include <cassert>
+#include <algorithm>
+#include <chrono>
 
 #include "types.hpp"
 
@@ -22,7 +24,7 @@ struct DenseSlot
 };
 
 template <typename Component>
-class ComponentPool : public IComponentPool
+class ComponentPool final : public IComponentPool
 {
     private:
         // NOTE: oportunidad de optimización: paginar m_sparse (supongo que afectará cuando hayan muchas entidades)
@@ -30,6 +32,100 @@ class ComponentPool : public IComponentPool
         std::vector<uint32_t> m_sparse; // -> sparse vector := cada índice es un EntityId, el valor es un índice del vector denso
         std::vector<DenseSlot<Component>> m_dense; // -> dense vector := cada slot tiene un componente 
                                                    // y el id de la entidad a la que pertenece
+
+        // time-slicing: cada llamada (y cada vuelta que empieza dentro de una llamada) toma un número de serie
+        // que se guarda como stamp de las entidades que procesa. una entidad está pendiente en la vuelta actual
+        // si su stamp es menor a m_slice_round_start. stamps se indexan por entity id (no viven en el slot),
+        // así no se mueven en swap-and-pop ni en sort, y pools que nunca se procesan por ventanas no pagan por ellos
+        std::vector<uint32_t> m_slice_stamps; // -> vacío hasta la primera llamada de time-slicing
+        std::vector<EntityId> m_slice_deferred; // -> pendientes que quedaron detrás del cursor, se procesan al cierre de la vuelta
+        uint32_t m_slice_deferred_head = 0; // -> siguiente diferido a procesar (en orden de llegada)
+        uint32_t m_slice_cursor = 0; // -> siguiente índice denso a revisar, [0, m_slice_cursor) solo tiene pendientes diferidos
+        uint32_t m_slice_serial = 1; // -> último número de serie entregado
+        uint32_t m_slice_round_start = 1; // -> serie con que empezó la vuelta actual
+        uint32_t m_slice_round_size = 0; // -> tamaño del pool al empezar la vuelta actual
+        uint32_t m_slice_prev_round_size = 0; // -> tamaño del pool al empezar la vuelta anterior
+        uint32_t m_slice_round_removals = 0; // -> slots removidos durante la vuelta actual
+        uint32_t m_slice_prev_round_removals = 0; // -> slots removidos durante la vuelta anterior
+
+        // should_stop(processed_count, visited_count) se consulta tras cada slot recorrido (procesado o saltado)
+        template <typename Function, typename ShouldStop>
+        uint32_t process_window(Function &function, ShouldStop should_stop)
+        {
+            if (m_slice_stamps.empty()) m_slice_stamps.assign(MAX_ENTITIES, 0);
+
+            uint32_t call_serial = ++m_slice_serial;
+            uint32_t stamp = call_serial; // -> serie con que se marcan los slots procesados
+            uint32_t processed_count = 0;
+            uint32_t visited_count = 0;
+
+            while (true)
+            {
+                DenseSlot<Component> *slot;
+                bool deferred = m_slice_cursor >= m_dense.size();
+                if (!deferred)
+                {
+                    slot = &m_dense[m_slice_cursor];
+                }
+                else if (m_slice_deferred_head < m_slice_deferred.size())
+                {
+                    // fin del vector denso: se cierra la vuelta con los pendientes diferidos
+                    uint32_t dense_index = m_sparse[m_slice_deferred[m_slice_deferred_head]];
+                    if (dense_index == INVALID)
+                    {
+                        m_slice_deferred_head++; // -> entidad ya no tiene el componente
+                        continue;
+                    }
+                    slot = &m_dense[dense_index];
+                }
+                else
+                {
+                    // vuelta completa: la nueva vuelta toma una serie propia, así los slots procesados en esta llamada
+                    // antes de dar la vuelta quedan pendientes en la nueva vuelta igual que el resto
+                    m_slice_deferred.clear();
+                    m_slice_deferred_head = 0;
+                    if (stamp != call_serial || m_dense.empty()) break; // -> a lo más una vuelta nueva por llamada
+                    stamp = ++m_slice_serial;
+                    m_slice_round_start = stamp;
+                    m_slice_prev_round_size = m_slice_round_size;
+                    m_slice_round_size = m_dense.size();
+                    m_slice_prev_round_removals = m_slice_round_removals;
+                    m_slice_round_removals = 0;
+                    m_slice_cursor = 0;
+                    continue;
+                }
+
+                uint32_t &slot_stamp = m_slice_stamps[slot->entity_id];
+
+                // slot ya procesado en esta llamada antes de dar la vuelta: queda pendiente en la nueva vuelta
+                // pero no se repite en esta llamada, en el vector denso se difiere y en los diferidos se detiene la llamada
+                if (stamp != call_serial && slot_stamp == call_serial)
+                {
+                    if (deferred) break;
+                    m_slice_deferred.push_back(slot->entity_id);
+                    m_slice_cursor++;
+                    visited_count++;
+                    if (should_stop(processed_count, visited_count)) break;
+                    continue;
+                }
+
+                // se avanza antes de llamar a function, así si esta remueve la entidad actual
+                // el slot queda en la zona ya revisada y no se vuelve a visitar
+                if (deferred) m_slice_deferred_head++;
+                else m_slice_cursor++;
+                visited_count++;
+
+                if (slot_stamp < m_slice_round_start) // -> si no, ya fue procesado en esta vuelta (ej: tras un sort)
+                {
+                    slot_stamp = stamp;
+                    function(*slot);
+                    processed_count++;
+                }
+
+                if (should_stop(processed_count, visited_count)) break;
+            }
+            return processed_count;
+        }
     
     public:
         ComponentPool()
@@ -48,6 +144,9 @@ class ComponentPool : public IComponentPool
             // se crea un nuevo slot para agregar al vector denso
             DenseSlot<Component> new_slot = {entity_id, Component()}; // se inicializa component con default constructor
             m_dense.push_back(new_slot);
+            // time-slicing: slot nuevo entra en la siguiente vuelta, así agregar entidades durante una vuelta
+            // no la alarga indefinidamente (y no se atrasa al resto)
+            if (!m_slice_stamps.empty()) m_slice_stamps[entity_id] = m_slice_round_start;
 
             // se agrega el índice del slot en el vector denso al sparse, indexado por id de entidad
             m_sparse[entity_id] = m_dense.size() - 1;
@@ -70,12 +169,24 @@ class ComponentPool : public IComponentPool
             // que se movió, apunte a su nuevo índice en el vector denso
             EntityId last_entity_id = m_dense[dense_index].entity_id;
             m_sparse[last_entity_id] = dense_index;
+
+            // time-slicing: si el slot movido quedó detrás del cursor sin procesarse en esta vuelta,
+            // se difiere al cierre de la vuelta (donde estaba antes de moverse) para no saltarlo
+            if (!m_slice_stamps.empty() && dense_index < m_slice_cursor && last_dense_index >= m_slice_cursor
+                && m_slice_stamps[last_entity_id] < m_slice_round_start)
+            {
+                m_slice_deferred.push_back(last_entity_id);
+            }
             
             // se elimina último slot del vector denso
             m_dense.pop_back();
         
             // se marca índice del componente eliminado como inválido en el sparse vector
             m_sparse[entity_id] = INVALID;
+
+            if (m_slice_stamps.empty()) return;
+            if (m_slice_cursor > m_dense.size()) m_slice_cursor = m_dense.size(); // -> slots agregados después quedan por delante
+            m_slice_round_removals++;
         }
         
         Component& get_component(EntityId entity_id)
@@ -107,4 +218,76 @@ class ComponentPool : public IComponentPool
             return m_dense;
         }
 
+        template <typename Compare>
+        void sort(Compare compare)
+        {
+            // se ordena el vector denso de forma estable según compare(a, b) sobre los componentes
+            std::stable_sort(m_dense.begin(), m_dense.end(),
+                [&compare](const DenseSlot<Component>& a, const DenseSlot<Component>& b)
+                {
+                    return compare(a.component, b.component);
+                });
+
+            // se reconstruye sparse vector con los nuevos índices densos
+            for (uint32_t dense_index = 0; dense_index < m_dense.size(); dense_index++)
+            {
+                m_sparse[m_dense[dense_index].entity_id] = dense_index;
+            }
+
+            // orden cambió: cursor pasa al primer slot pendiente de la vuelta actual,
+            // los ya procesados conservan su stamp y se saltan, así la vuelta continúa sin repetir ni dejar entidades atrás
+            if (m_slice_stamps.empty()) return;
+            m_slice_deferred.clear(); // -> todos los pendientes quedan desde el cursor en adelante
+            m_slice_deferred_head = 0;
+            m_slice_cursor = 0;
+            while (m_slice_cursor < m_dense.size() && m_slice_stamps[m_dense[m_slice_cursor].entity_id] >= m_slice_round_start)
+            {
+                m_slice_cursor++;
+            }
+        }
+
+        // -- time-slicing --
+        // se procesan hasta max_count slots desde el cursor, continuando donde quedó la llamada anterior.
+        // ningún slot se procesa dos veces en una misma llamada ni se salta dentro de una vuelta
+        // (slots agregados durante una vuelta entran en la siguiente).
+        // function(DenseSlot<Component> &slot) puede remover componentes de este pool
+        template <typename Function>
+        uint32_t process_slice(uint32_t max_count, Function function)
+        {
+            if (max_count == 0) return 0;
+            return process_window(function, [max_count](uint32_t processed_count, uint32_t) { return processed_count >= max_count; });
+        }
+
+        // se procesan slots desde el cursor hasta agotar el presupuesto de tiempo (al menos uno por llamada)
+        template <typename Function>
+        uint32_t process_slice_for(std::chrono::microseconds budget, Function function)
+        {
+            constexpr uint32_t CLOCK_CHECK_INTERVAL = 16; // -> se consulta el reloj cada N slots para abaratar el chequeo
+            auto deadline = std::chrono::steady_clock::now() + budget;
+
+            // reloj se consulta tras el primer slot procesado y luego cada N slots recorridos (incluye los saltados)
+            return process_window(function, [deadline, next_check = 0u](uint32_t processed_count, uint32_t visited_count) mutable
+            {
+                if (processed_count == 0 || visited_count < next_check) return false;
+                next_check = visited_count + CLOCK_CHECK_INTERVAL;
+                return std::chrono::steady_clock::now() >= deadline;
+            });
+        }
+
+        // tamaño sobre el que se calcula la ventana de una fracción del pool: el mayor entre el tamaño actual
+        // y el de inicio de esta vuelta y la anterior, así remover entidades ya procesadas no achica la ventana
+        // mientras queda trabajo de esas vueltas. se suman las remociones de ambas vueltas porque swap-and-pop
+        // puede adelantar un slot ya procesado a la vuelta siguiente (un slot extra por remoción).
+        // así el periodo de cada entidad se mantiene en ceil(1 / fracción) llamadas
+        uint32_t get_slice_size() const
+        {
+            uint32_t size = std::max<uint32_t>({static_cast<uint32_t>(m_dense.size()), m_slice_round_size, m_slice_prev_round_size});
+            return size + m_slice_round_removals + m_slice_prev_round_removals;
+        }
+
+        uint32_t get_slice_cursor() const
+        {
+            return m_slice_cursor;
+        }
+
 };
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <chrono>
+#include <cmath>
 #include <memory>
+#include <type_traits>
 
 #include "entityManager.hpp"
 #include "componentManager.hpp"
 #include "types.hpp"
 #include "componentPool.hpp"
+#include "hierarchy.hpp"
+#include "eventBus.hpp"
 
 using namespace ecs_types;
 
@@ -14,37 +19,125 @@ class ECS
     private:
         std::unique_ptr<EntityManager> m_entity_manager;
         std::unique_ptr<ComponentManager> m_component_manager;
+        std::unique_ptr<EventBus> m_event_bus;
+
+        bool m_hierarchy_dirty = false; // -> indica si el pool de jerarquía perdió el orden por profundidad
+
+        // se desenlaza la entidad de la lista de hijos de su padre (queda como raíz)
+        void detach_from_parent(EntityId entity_id)
+        {
+            HierarchyComponent& hierarchy = m_component_manager->get_component<HierarchyComponent>(entity_id);
+            if (hierarchy.parent == INVALID) return;
+
+            if (hierarchy.prev_sibling != INVALID)
+            {
+                m_component_manager->get_component<HierarchyComponent>(hierarchy.prev_sibling).next_sibling = hierarchy.next_sibling;
+            }
+            else
+            {
+                // era el primer hijo, se actualiza cabeza de la lista en el padre
+                m_component_manager->get_component<HierarchyComponent>(hierarchy.parent).first_child = hierarchy.next_sibling;
+            }
+
+            if (hierarchy.next_sibling != INVALID)
+            {
+                m_component_manager->get_component<HierarchyComponent>(hierarchy.next_sibling).prev_sibling = hierarchy.prev_sibling;
+            }
+
+            hierarchy.parent = INVALID;
+            hierarchy.next_sibling = INVALID;
+            hierarchy.prev_sibling = INVALID;
+        }
+
+        // se recalcula la profundidad de todo el subárbol a partir de la raíz dada
+        void update_subtree_depth(EntityId root_id, uint32_t root_depth)
+        {
+            m_component_manager->get_component<HierarchyComponent>(root_id).depth = root_depth;
+            for_each_in_subtree(root_id, [this, root_id](EntityId entity_id)
+            {
+                if (entity_id == root_id) return;
+
+                // recorrido en preorden => el padre ya tiene su profundidad actualizada
+                HierarchyComponent& hierarchy = m_component_manager->get_component<HierarchyComponent>(entity_id);
+                hierarchy.depth = m_component_manager->get_component<HierarchyComponent>(hierarchy.parent).depth + 1;
+            });
+
+            m_hierarchy_dirty = true;
+        }
+
+        void ensure_hierarchy_component(EntityId entity_id)
+        {
+            if (m_component_manager->has_component<HierarchyComponent>(entity_id)) return;
+            add_component<HierarchyComponent>(entity_id);
+        }
 
     public:
         ECS()
         {
             m_entity_manager = std::make_unique<EntityManager>();
             m_component_manager = std::make_unique<ComponentManager>();
+            m_event_bus = std::make_unique<EventBus>();
+
+            // componente de jerarquía viene registrado por defecto
+            m_component_manager->register_component<HierarchyComponent>();
         }
         ~ECS() {};
         
         // -- entities --
+        // NOTE: create_entity es thread-safe (lock-free); agregar componentes no lo es,
+        // por lo que hilos de trabajo solo reservan entidades y los componentes se agregan en un punto de sincronización
         EntityId create_entity()
         {
             return m_entity_manager->create_entity();
         }
 
+        // caché de ids para un hilo de trabajo, reserva batch_size ids por recarga desde la lista libre global
+        EntityIdCache make_entity_id_cache(uint32_t batch_size = 64)
+        {
+            return EntityIdCache(*m_entity_manager, batch_size);
+        }
+
+        bool is_entity_alive(EntityId entity_id)
+        {
+            return m_entity_manager->is_entity_alive(entity_id);
+        }
+
+        uint32_t get_living_entity_count()
+        {
+            return m_entity_manager->get_living_entity_count();
+        }
+
         void destroy_entity(EntityId entity_id)
         {
             assert(entity_id < MAX_ENTITIES && "Entidad no válida");
             assert(m_entity_manager->is_entity_alive(entity_id) && "Entidad ya destruida previametne");
 
+            if (m_component_manager->has_component<HierarchyComponent>(entity_id))
+            {
+                // se destruyen recursivamente los hijos (cada uno se desenlaza de esta lista al destruirse)
+                while (m_component_manager->get_component<HierarchyComponent>(entity_id).first_child != INVALID)
+                {
+                    destroy_entity(m_component_manager->get_component<HierarchyComponent>(entity_id).first_child);
+                }
+
+                detach_from_parent(entity_id);
+                m_hierarchy_dirty = true; // -> swap-and-pop del pool rompe el orden por profundidad
+            }
+
             Signature entity_signature = m_entity_manager->get_signature(entity_id);
             
-            // se recorre la signature (bitset) de la entidad y se eliminan los componentes cuyo bit esté en 1
-            for (ComponentTypeId type_id = 0; type_id < MAX_COMPONENTS; type_id++)
+            // se recorre la signature de la entidad por palabras y solo se visitan los bits en 1
+            for (uint32_t word_index = 0; word_index < SIGNATURE_WORDS; word_index++)
             {
-                if (entity_signature.test(type_id))
+                uint32_t word = entity_signature.words[word_index];
+                while (word != 0)
                 {
+                    ComponentTypeId type_id = word_index * 32 + __builtin_ctz(word);
+                    word &= word - 1; // -> se apaga el bit menos significativo
+
                     // remover componente de entidad mediante type_id
                     m_component_manager->remove_component_by_type_id(entity_id, type_id);
                 }
-                
             }
             
             m_entity_manager->destroy_entity(entity_id);
@@ -60,19 +153,57 @@ class ECS
         template <typename Component>
         Component& add_component(EntityId entity_id)
         {
-            m_component_manager->add_component<Component>(entity_id);
-            
-            // se actualiza signature de entidad
             ComponentTypeId type_id = m_component_manager->get_component_type_id<Component>();
-            m_entity_manager->add_component_to_signature(entity_id, type_id);
-        
-            return m_component_manager->get_component<Component>(entity_id);
+
+            if constexpr (std::is_empty_v<Component>)
+            {
+                // tag: no tiene pool, solo se activa su bit en la signature
+                assert(m_component_manager->is_component_registered<Component>() && "Componente no registrado");
+                m_entity_manager->add_component_to_signature(entity_id, type_id);
+
+                static Component tag;
+                return tag;
+            }
+            else
+            {
+                m_component_manager->add_component<Component>(entity_id);
+
+                // se actualiza signature de entidad
+                m_entity_manager->add_component_to_signature(entity_id, type_id);
+
+                if constexpr (std::is_same_v<Component, HierarchyComponent>)
+                {
+                    m_hierarchy_dirty = true; // -> nueva raíz queda al final del pool
+                }
+
+                return m_component_manager->get_component<Component>(entity_id);
+            }
         }
 
         template <typename Component>
         void remove_component(EntityId entity_id)
         {
-            m_component_manager->remove_component<Component>(entity_id);
+            if constexpr (std::is_same_v<Component, HierarchyComponent>)
+            {
+                // los hijos pasan a ser raíces y la entidad se desenlaza de su padre
+                HierarchyComponent& hierarchy = m_component_manager->get_component<HierarchyComponent>(entity_id);
+                while (hierarchy.first_child != INVALID)
+                {
+                    remove_parent(hierarchy.first_child);
+                }
+
+                detach_from_parent(entity_id);
+                m_hierarchy_dirty = true;
+            }
+
+            if constexpr (std::is_empty_v<Component>)
+            {
+                assert(m_component_manager->is_component_registered<Component>() && "Componente no registrado");
+            }
+            else
+            {
+                m_component_manager->remove_component<Component>(entity_id);
+            }
 
             // se actualiza signature de entidad
             ComponentTypeId type_id = m_component_manager->get_component_type_id<Component>();
@@ -83,14 +214,34 @@ class ECS
         Component& get_component(EntityId entity_id)
         {
             assert(entity_id < MAX_ENTITIES && "Entidad no válida");
-            return m_component_manager->get_component<Component>(entity_id);
+
+            if constexpr (std::is_empty_v<Component>)
+            {
+                assert(has_component<Component>(entity_id) && "Entidad no tiene este componente");
+                static Component tag;
+                return tag;
+            }
+            else
+            {
+                return m_component_manager->get_component<Component>(entity_id);
+            }
         }
         
         template <typename Component>
         bool has_component(EntityId entity_id)
         {
             assert(entity_id < MAX_ENTITIES && "Entidad no válida");
-            return m_component_manager->has_component<Component>(entity_id);
+
+            if constexpr (std::is_empty_v<Component>)
+            {
+                // tags se consultan directamente en la signature
+                assert(m_component_manager->is_component_registered<Component>() && "Componente no registrado");
+                return m_entity_manager->get_signature(entity_id).test(m_component_manager->get_component_type_id<Component>());
+            }
+            else
+            {
+                return m_component_manager->has_component<Component>(entity_id);
+            }
         }
         
         template <typename Component>
@@ -99,4 +250,256 @@ class ECS
             return m_component_manager->get_component_dense_vector<Component>();
         }
 
+        // -- time-slicing --
+        // se procesa una ventana rotativa del pool por llamada, continuando donde quedó la anterior
+        // (ej: fraction = 0.25 => cada entidad se procesa una vez cada 4 llamadas).
+        // function(DenseSlot<Component> &slot) puede remover componentes sin que se salten entidades
+        template <typename Component, typename Function>
+        uint32_t update_sliced(float fraction, Function function)
+        {
+            assert(fraction > 0.0f && fraction <= 1.0f && "Fracción inválida");
+            ComponentPool<Component>& pool = m_component_manager->get_component_pool<Component>();
+            uint32_t window_count = static_cast<uint32_t>(std::ceil(pool.get_slice_size() * fraction));
+            return pool.process_slice(window_count, function);
+        }
+
+        // se procesa desde el cursor hasta agotar el presupuesto de tiempo (al menos una entidad por llamada)
+        template <typename Component, typename Function>
+        uint32_t update_budgeted(std::chrono::microseconds budget, Function function)
+        {
+            ComponentPool<Component>& pool = m_component_manager->get_component_pool<Component>();
+            return pool.process_slice_for(budget, function);
+        }
+
+        // -- shared components --
+        template <typename Component>
+        void register_shared_component()
+        {
+            m_component_manager->register_shared_component<Component>();
+        }
+
+        // se agrega o reemplaza el valor compartido de la entidad (se deduplica con los valores existentes)
+        template <typename Component>
+        void set_shared_component(EntityId entity_id, const Component &value)
+        {
+            assert(entity_id < MAX_ENTITIES && "Entidad no válida");
+            m_component_manager->get_shared_component_pool<Component>().set_component(entity_id, value);
+
+            // se actualiza signature de entidad
+            ComponentTypeId type_id = m_component_manager->get_component_type_id<Component>();
+            m_entity_manager->add_component_to_signature(entity_id, type_id);
+        }
+
+        // copia del valor compartido (referencias a la tabla se invalidan al insertar valores nuevos)
+        template <typename Component>
+        Component get_shared_component(EntityId entity_id)
+        {
+            assert(entity_id < MAX_ENTITIES && "Entidad no válida");
+            return m_component_manager->get_shared_component_pool<Component>().get_component(entity_id);
+        }
+
+        // copy-on-write: modify(Component &copy) modifica una copia, el resto de entidades no se ve afectado
+        template <typename Component, typename Modify>
+        void modify_shared_component(EntityId entity_id, Modify modify)
+        {
+            assert(entity_id < MAX_ENTITIES && "Entidad no válida");
+            m_component_manager->get_shared_component_pool<Component>().modify_component(entity_id, modify);
+        }
+
+        template <typename Component>
+        void remove_shared_component(EntityId entity_id)
+        {
+            assert(entity_id < MAX_ENTITIES && "Entidad no válida");
+            m_component_manager->get_shared_component_pool<Component>().remove_component(entity_id);
+
+            ComponentTypeId type_id = m_component_manager->get_component_type_id<Component>();
+            m_entity_manager->remove_component_from_signature(entity_id, type_id);
+        }
+
+        template <typename Component>
+        bool has_shared_component(EntityId entity_id)
+        {
+            assert(entity_id < MAX_ENTITIES && "Entidad no válida");
+            return m_component_manager->get_shared_component_pool<Component>().has_component(entity_id);
+        }
+
+        // function(const Component &value, const DenseSlot<SharedValueIndex> *slots, size_t count)
+        // se llama una vez por valor compartido con todas las entidades que lo usan
+        // (sin agregar, modificar ni remover componentes compartidos de este tipo durante el recorrido)
+        template <typename Component, typename Function>
+        void for_each_shared_group(Function function)
+        {
+            m_component_manager->get_shared_component_pool<Component>().for_each_group(function);
+        }
+
+        // -- queries --
+        template <typename... Components>
+        Signature get_signature_mask()
+        {
+            // un tipo no registrado tomaría un type id nuevo sin bit propio en las signatures
+            assert((m_component_manager->is_component_registered<Components>() && ...) && "Componente no registrado");
+
+            Signature mask;
+            (mask.set(m_component_manager->get_component_type_id<Components>()), ...);
+            return mask;
+        }
+
+        // entidades vivas que tienen todos los componentes de include y ninguno de exclude
+        // (se escanean las signatures con SIMD, útil para filtrar por varios tags a la vez)
+        void query(const Signature &include, const Signature &exclude, std::vector<EntityId> &out)
+        {
+            m_entity_manager->query(include, exclude, out);
+        }
+
+        // -- events --
+        template <typename Event>
+        void register_event()
+        {
+            m_event_bus->register_event<Event>();
+        }
+
+        // segment identifica al hilo que envía (0 = hilo principal), ver MAX_EVENT_SEGMENTS
+        template <typename Event>
+        void send_event(const Event &event, uint32_t segment = 0)
+        {
+            m_event_bus->send<Event>(event, segment);
+        }
+
+        // function(const Event &event) por cada evento legible en este frame
+        template <typename Event, typename Function>
+        void read_events(Function function)
+        {
+            m_event_bus->get_event_queue<Event>().read(function);
+        }
+
+        // function(const Event *events, size_t count) por cada segmento con eventos
+        template <typename Event, typename Function>
+        void read_event_batches(Function function)
+        {
+            m_event_bus->get_event_queue<Event>().read_batches(function);
+        }
+
+        template <typename Event>
+        EventQueue<Event>& get_event_queue()
+        {
+            return m_event_bus->get_event_queue<Event>();
+        }
+
+        // se intercambian buffers de todas las colas: eventos del frame pasan a ser legibles
+        void update_events()
+        {
+            m_event_bus->update();
+        }
+
+        // -- hierarchy --
+        void set_parent(EntityId child_id, EntityId parent_id)
+        {
+            assert(child_id < MAX_ENTITIES && parent_id < MAX_ENTITIES && "Entidad no válida");
+            assert(child_id != parent_id && "Entidad no puede ser su propio padre");
+
+            ensure_hierarchy_component(child_id);
+            ensure_hierarchy_component(parent_id);
+
+            // se revisa que el nuevo padre no sea descendiente del hijo (evita ciclos)
+            for (EntityId ancestor = parent_id; ancestor != INVALID;
+                 ancestor = m_component_manager->get_component<HierarchyComponent>(ancestor).parent)
+            {
+                assert(ancestor != child_id && "Reparentado generaría un ciclo");
+            }
+
+            detach_from_parent(child_id);
+
+            // se inserta como primer hijo del nuevo padre
+            HierarchyComponent& parent = m_component_manager->get_component<HierarchyComponent>(parent_id);
+            HierarchyComponent& child = m_component_manager->get_component<HierarchyComponent>(child_id);
+            child.parent = parent_id;
+            child.next_sibling = parent.first_child;
+            if (parent.first_child != INVALID)
+            {
+                m_component_manager->get_component<HierarchyComponent>(parent.first_child).prev_sibling = child_id;
+            }
+            parent.first_child = child_id;
+
+            update_subtree_depth(child_id, parent.depth + 1);
+        }
+
+        void remove_parent(EntityId entity_id)
+        {
+            assert(entity_id < MAX_ENTITIES && "Entidad no válida");
+            assert(m_component_manager->has_component<HierarchyComponent>(entity_id) && "Entidad no tiene jerarquía");
+
+            detach_from_parent(entity_id);
+            update_subtree_depth(entity_id, 0);
+        }
+
+        EntityId get_parent(EntityId entity_id)
+        {
+            assert(entity_id < MAX_ENTITIES && "Entidad no válida");
+            if (!m_component_manager->has_component<HierarchyComponent>(entity_id)) return INVALID;
+
+            return m_component_manager->get_component<HierarchyComponent>(entity_id).parent;
+        }
+
+        template <typename Function>
+        void for_each_child(EntityId entity_id, Function function)
+        {
+            assert(entity_id < MAX_ENTITIES && "Entidad no válida");
+            if (!m_component_manager->has_component<HierarchyComponent>(entity_id)) return;
+
+            EntityId child_id = m_component_manager->get_component<HierarchyComponent>(entity_id).first_child;
+            while (child_id != INVALID)
+            {
+                // se lee el siguiente antes de llamar a function por si esta modifica la jerarquía
+                EntityId next_id = m_component_manager->get_component<HierarchyComponent>(child_id).next_sibling;
+                function(child_id);
+                child_id = next_id;
+            }
+        }
+
+        // recorrido en preorden (padres antes que hijos) del subárbol, incluyendo la raíz
+        // NOTE: function no debe modificar la jerarquía durante el recorrido
+        template <typename Function>
+        void for_each_in_subtree(EntityId root_id, Function function)
+        {
+            assert(root_id < MAX_ENTITIES && "Entidad no válida");
+            assert(m_component_manager->has_component<HierarchyComponent>(root_id) && "Entidad no tiene jerarquía");
+
+            EntityId current_id = root_id;
+            while (true)
+            {
+                function(current_id);
+
+                const HierarchyComponent* current = &m_component_manager->get_component<HierarchyComponent>(current_id);
+                if (current->first_child != INVALID)
+                {
+                    current_id = current->first_child;
+                    continue;
+                }
+
+                // se sube hasta encontrar un ancestro con hermano siguiente (sin salir del subárbol)
+                while (current_id != root_id && current->next_sibling == INVALID)
+                {
+                    current_id = current->parent;
+                    current = &m_component_manager->get_component<HierarchyComponent>(current_id);
+                }
+                if (current_id == root_id) return;
+
+                current_id = current->next_sibling;
+            }
+        }
+
+        // pool de jerarquía ordenado por profundidad: todo padre aparece antes que sus hijos,
+        // por lo que propagar transforms de padre a hijo es una única pasada lineal
+        std::vector<DenseSlot<HierarchyComponent>>& get_hierarchy_dense_vector()
+        {
+            if (m_hierarchy_dirty)
+            {
+                m_component_manager->sort_components<HierarchyComponent>(
+                    [](const HierarchyComponent& a, const HierarchyComponent& b) { return a.depth < b.depth; });
+                m_hierarchy_dirty = false;
+            }
+
+            return m_component_manager->get_component_dense_vector<HierarchyComponent>();
+        }
+
 };
@@ -1,24 +1,34 @@
 #pragma once
 
 #include <assert.h>
+#include <atomic>
+#include <memory>
 #include <vector>
 
 #include "types.hpp"
 
 using namespace ecs_types;
 
+// NOTE: creación/destrucción de entidades es thread-safe y lock-free (lista libre global con CAS),
+// las signatures en cambio solo las debe modificar el hilo dueño de la entidad
 class EntityManager
 {
     private:
-        std::vector<EntityId> m_available_entities; // -> entidades disponibles (se usa como stack)
+        std::unique_ptr<std::atomic<EntityId>[]> m_next_available; // -> lista libre intrusiva: siguiente id disponible
+                                                                    // después de cada id (INVALID si es el último)
+        std::atomic<uint64_t> m_available_head; // -> cabeza de la lista libre (se usa como stack),
+                                                // 32 bits altos = tag que se incrementa en cada cambio (evita ABA),
+                                                // 32 bits bajos = id de la entidad disponible en el tope
         std::vector<Signature> m_signatures; // -> firma de cada entidad (qué componentes tiene),
                                              // cada bit representa si tiene un componente o no,
                                              // indexado por type id del componente
-        
-        std::vector<bool> m_alive_entities; // -> vector de flags para saber si entidades vivas o no 
 
-        size_t m_living_entity_count = 0; // -> número de entidades vivas
-    
+        std::unique_ptr<std::atomic<bool>[]> m_alive_entities; // -> flags para saber si entidades vivas o no
+
+        std::atomic<uint32_t> m_living_entity_count{0}; // -> número de entidades vivas
+
+        void push_available_entities(EntityId first_id, EntityId last_id);
+
     public:
         EntityManager();
         ~EntityManager();
@@ -27,15 +37,64 @@ class EntityManager
         void destroy_entity(EntityId entity_id);
         bool is_entity_alive(EntityId entity_id) const;
 
+        // se sacan hasta count ids de la lista libre con un único CAS (no quedan vivas aún),
+        // retorna cuántos se obtuvieron
+        uint32_t reserve_entity_ids(uint32_t count, EntityId *out);
+        void release_entity_ids(const EntityId *ids, uint32_t count); // -> devuelve ids reservados sin usar
+        void activate_entity(EntityId entity_id); // -> marca como viva una entidad previamente reservada
 
         void set_signature(EntityId entity_id, Signature signature);
         Signature get_signature(EntityId entity_id) const;
         void add_component_to_signature(EntityId entity_id, ComponentTypeId type_id);
         void remove_component_from_signature(EntityId entity_id, ComponentTypeId type_id);
 
+        // se llenan en out las entidades vivas cuya signature contiene include y no intersecta exclude
+        void query(const Signature &include, const Signature &exclude, std::vector<EntityId> &out) const;
+
         uint32_t get_living_entity_count() const;
 
 };
 
+// caché de ids por hilo: se rellena en lotes desde la lista libre global del EntityManager,
+// así los hilos de trabajo crean entidades sin competir por la cabeza de la lista en cada creación.
+// los componentes se agregan después, en un punto de sincronización
+class EntityIdCache
+{
+    private:
+        EntityManager &m_entity_manager;
+        std::vector<EntityId> m_reserved_ids; // -> ids reservados para este hilo (se usa como stack)
+        uint32_t m_batch_size; // -> cantidad de ids a reservar en cada recarga
+
+    public:
+        EntityIdCache(EntityManager &entity_manager, uint32_t batch_size)
+            : m_entity_manager(entity_manager), m_batch_size(batch_size)
+        {
+            assert(batch_size > 0 && "Tamaño de lote inválido");
+            m_reserved_ids.reserve(batch_size);
+        }
+        EntityIdCache(EntityIdCache &&other) = default;
+        ~EntityIdCache()
+        {
+            // ids no usados vuelven a la lista global
+            if (!m_reserved_ids.empty())
+            {
+                m_entity_manager.release_entity_ids(m_reserved_ids.data(), m_reserved_ids.size());
+            }
+        }
 
+        EntityId create_entity()
+        {
+            if (m_reserved_ids.empty())
+            {
+                m_reserved_ids.resize(m_batch_size);
+                uint32_t reserved_count = m_entity_manager.reserve_entity_ids(m_batch_size, m_reserved_ids.data());
+                m_reserved_ids.resize(reserved_count);
+                assert(!m_reserved_ids.empty() && "No hay entidades disponibles");
+            }
 
+            EntityId entity_id = m_reserved_ids.back();
+            m_reserved_ids.pop_back();
+            m_entity_manager.activate_entity(entity_id);
+            return entity_id;
+        }
+};
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "types.hpp"
+
+using namespace ecs_types;
+
+using EventTypeId = std::uint16_t;
+
+const uint32_t MAX_EVENT_SEGMENTS = 16; // -> segmentos de escritura por cola (uno por hilo, el 0 es del hilo principal)
+
+class IEventQueue
+{
+    public:
+        virtual ~IEventQueue() = default;
+        virtual void swap_buffers() = 0;
+};
+
+// cola de eventos de un tipo: cada segmento tiene doble buffer contiguo (lectura/escritura).
+// eventos enviados durante un frame se leen después del siguiente swap_buffers,
+// y los buffers se limpian sin liberar memoria (sin allocs en estado estable).
+// NOTE: hilos distintos pueden enviar en paralelo siempre que usen segmentos distintos,
+// swap_buffers se llama en un punto de sincronización
+template <typename Event>
+class EventQueue final : public IEventQueue
+{
+    private:
+        struct alignas(64) Segment // -> alineado a línea de caché para evitar false sharing entre hilos
+        {
+            std::vector<Event> buffers[2];
+        };
+
+        std::vector<Segment> m_segments;
+        uint32_t m_read_index = 0; // -> buffer de lectura de cada segmento (el otro es de escritura)
+
+    public:
+        EventQueue() : m_segments(MAX_EVENT_SEGMENTS) {}
+        ~EventQueue() {};
+
+        void send(const Event &event, uint32_t segment = 0)
+        {
+            assert(segment < MAX_EVENT_SEGMENTS && "Segmento de eventos inválido");
+            m_segments[segment].buffers[1 - m_read_index].push_back(event);
+        }
+
+        void swap_buffers() override
+        {
+            // buffer de escritura pasa a ser de lectura y el antiguo de lectura se limpia para escribir
+            m_read_index = 1 - m_read_index;
+            for (Segment &segment : m_segments)
+            {
+                segment.buffers[1 - m_read_index].clear();
+            }
+        }
+
+        // function(const Event *events, size_t count), una llamada por segmento no vacío
+        template <typename Function>
+        void read_batches(Function function) const
+        {
+            for (const Segment &segment : m_segments)
+            {
+                const std::vector<Event> &events = segment.buffers[m_read_index];
+                if (!events.empty()) function(events.data(), events.size());
+            }
+        }
+
+        // function(const Event &event)
+        template <typename Function>
+        void read(Function function) const
+        {
+            read_batches([&function](const Event *events, size_t count)
+            {
+                for (size_t i = 0; i < count; i++) function(events[i]);
+            });
+        }
+
+        size_t get_event_count() const
+        {
+            size_t count = 0;
+            for (const Segment &segment : m_segments) count += segment.buffers[m_read_index].size();
+            return count;
+        }
+};
+
+using EventQueues = std::unordered_map<EventTypeId, std::unique_ptr<IEventQueue>>;
+
+class EventBus
+{
+    private:
+        EventQueues m_event_queues; // -> mapea type ids de eventos a sus colas
+
+        // id único para siguiente tipo de evento, global al proceso (como en ComponentManager): los type ids
+        // son statics compartidos por todos los EventBus, así cada mundo puede registrar su propio conjunto de eventos
+        inline static std::atomic<EventTypeId> s_next_event_type_id{0};
+
+    public:
+        EventBus() = default;
+        ~EventBus() {};
+
+        template <typename Event>
+        void register_event()
+        {
+            EventTypeId type_id = get_event_type_id<Event>();
+            assert(m_event_queues.find(type_id) == m_event_queues.end() && "Evento ya registrado");
+
+            std::unique_ptr<IEventQueue> new_queue = std::make_unique<EventQueue<Event>>();
+            m_event_queues.emplace(type_id, std::move(new_queue));
+        }
+
+        template <typename Event>
+        EventTypeId get_event_type_id()
+        {
+            // static permite que type id se asigne una única vez por tipo de evento
+            static EventTypeId type_id = s_next_event_type_id.fetch_add(1, std::memory_order_relaxed);
+            return type_id;
+        }
+
+        // para loops calientes conviene guardar la referencia a la cola y evitar el lookup por evento
+        template <typename Event>
+        EventQueue<Event>& get_event_queue()
+        {
+            EventTypeId type_id = get_event_type_id<Event>();
+
+            // lookup de solo lectura con find (no operator[]), así varios hilos pueden llamar a send en paralelo
+            auto queue_it = m_event_queues.find(type_id);
+            assert(queue_it != m_event_queues.end() && "Evento no registrado");
+
+            IEventQueue *base_queue = queue_it->second.get();
+            return *static_cast<EventQueue<Event>*>(base_queue);
+        }
+
+        template <typename Event>
+        void send(const Event &event, uint32_t segment = 0)
+        {
+            get_event_queue<Event>().send(event, segment);
+        }
+
+        // se hacen legibles los eventos enviados desde el último update (llamar una vez por frame)
+        void update()
+        {
+            for (auto &[type_id, queue] : m_event_queues)
+            {
+                queue->swap_buffers();
+            }
+        }
+};
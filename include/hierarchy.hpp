@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+#include "types.hpp"
+
+using namespace ecs_types;
+
+// relación padre/hijo entre entidades, representada como lista enlazada intrusiva de hermanos
+// NOTE: no se modifica directamente, se maneja mediante ECS::set_parent / ECS::remove_parent
+struct HierarchyComponent
+{
+    EntityId parent = INVALID; // -> entidad padre (INVALID si es raíz)
+    EntityId first_child = INVALID; // -> primer hijo de la lista de hijos
+    EntityId next_sibling = INVALID; // -> siguiente hermano en la lista de hijos del padre
+    EntityId prev_sibling = INVALID; // -> hermano anterior en la lista de hijos del padre
+    uint32_t depth = 0; // -> profundidad en el árbol (0 para raíces), se usa para ordenar el pool
+};
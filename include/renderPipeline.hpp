@@ -0,0 +1,195 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "types.hpp"
+
+using namespace ecs_types;
+
+// tiempos acumulados del pipeline (en microsegundos)
+struct RenderPipelineStats
+{
+    uint64_t frames_published = 0;
+    uint64_t frames_consumed = 0;
+    uint64_t producer_wait_us = 0; // -> tiempo que simulación estuvo bloqueada esperando al consumidor
+    uint64_t consumer_wait_us = 0; // -> tiempo que consumidor estuvo bloqueado esperando un frame
+    uint64_t elapsed_us = 0; // -> tiempo desde la creación del buffer hasta ahora (o hasta stop)
+
+    // tiempo en que ningún hilo estuvo bloqueado en el pipeline: (elapsed - producer_wait) + (elapsed - consumer_wait) - elapsed
+    // NOTE: con un solo core ambos hilos se turnan, por lo que esto mide solapamiento posible y no paralelismo real
+    uint64_t get_overlap_us() const
+    {
+        uint64_t waits = producer_wait_us + consumer_wait_us;
+        return elapsed_us > waits ? elapsed_us - waits : 0;
+    }
+};
+
+// doble buffer de instancias de render extraídas del mundo:
+// simulación (productor) llena un buffer contiguo mientras el consumidor (render) lee el frame anterior,
+// así la simulación del frame N+1 corre en paralelo con el consumo del frame N.
+// el productor nunca va más de un frame adelantado (espera a que el consumidor tome el frame publicado)
+template <typename Instance>
+class RenderExtractionBuffer
+{
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        std::vector<Instance> m_buffers[2]; // -> se limpian cada frame sin liberar memoria
+        uint32_t m_write_index = 0; // -> buffer que llena el productor
+        uint32_t m_ready_index = INVALID; // -> buffer publicado aún no tomado por el consumidor
+        uint32_t m_reading_index = INVALID; // -> buffer que está leyendo el consumidor
+        bool m_stopped = false;
+
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+
+        RenderPipelineStats m_stats;
+        Clock::time_point m_start_time = Clock::now(); // -> ambos lados miden sus esperas desde aquí
+        Clock::time_point m_stop_time; // -> se congela elapsed al detener el pipeline
+
+        static uint64_t elapsed_us_since(Clock::time_point start)
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+        }
+
+    public:
+        RenderExtractionBuffer() = default;
+        ~RenderExtractionBuffer() {};
+
+        // -- productor --
+        // retorna buffer vacío para escribir el siguiente frame (nullptr si el pipeline se detuvo)
+        std::vector<Instance>* begin_write()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            Clock::time_point wait_start = Clock::now();
+            m_condition.wait(lock, [this]
+            {
+                return m_stopped || (m_ready_index == INVALID && m_reading_index != m_write_index);
+            });
+            m_stats.producer_wait_us += elapsed_us_since(wait_start);
+            if (m_stopped) return nullptr;
+
+            std::vector<Instance>& buffer = m_buffers[m_write_index];
+            buffer.clear(); // -> mantiene capacidad, sin allocs en estado estable
+            return &buffer;
+        }
+
+        void publish()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_ready_index = m_write_index;
+                m_write_index = 1 - m_write_index;
+                m_stats.frames_published++;
+            }
+            m_condition.notify_all();
+        }
+
+        // extrae con extract(world, buffer) y publica, retorna false si el pipeline se detuvo
+        template <typename World, typename Extract>
+        bool extract(World &world, Extract extract)
+        {
+            std::vector<Instance>* buffer = begin_write();
+            if (buffer == nullptr) return false;
+
+            extract(world, *buffer);
+            publish();
+            return true;
+        }
+
+        // -- consumidor --
+        // espera el siguiente frame publicado (nullptr si el pipeline se detuvo)
+        const std::vector<Instance>* acquire()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            Clock::time_point wait_start = Clock::now();
+            m_condition.wait(lock, [this] { return m_stopped || m_ready_index != INVALID; });
+            m_stats.consumer_wait_us += elapsed_us_since(wait_start);
+            if (m_stopped) return nullptr;
+
+            m_reading_index = m_ready_index;
+            m_ready_index = INVALID;
+            lock.unlock();
+            m_condition.notify_all(); // -> productor puede empezar a llenar el otro buffer
+
+            return &m_buffers[m_reading_index];
+        }
+
+        void release()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_reading_index == INVALID) return;
+
+                m_reading_index = INVALID;
+                m_stats.frames_consumed++;
+            }
+            m_condition.notify_all();
+        }
+
+        // despierta a ambos lados, begin_write y acquire retornan nullptr desde ahora
+        void stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_stopped) return;
+                m_stopped = true;
+                m_stop_time = Clock::now();
+            }
+            m_condition.notify_all();
+        }
+
+        RenderPipelineStats get_stats()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            RenderPipelineStats stats = m_stats;
+            Clock::time_point end_time = m_stopped ? m_stop_time : Clock::now();
+            stats.elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(end_time - m_start_time).count();
+            return stats;
+        }
+};
+
+// consumidor sin ventana: consume frames en su propio hilo llamando a consume(instances),
+// útil para tests y para medir el solapamiento del pipeline sin depender de un backend gráfico
+template <typename Instance>
+class HeadlessRenderConsumer
+{
+    private:
+        RenderExtractionBuffer<Instance> &m_buffer;
+        std::function<void(const std::vector<Instance>&)> m_consume;
+        std::thread m_thread;
+
+        void run()
+        {
+            while (const std::vector<Instance>* instances = m_buffer.acquire())
+            {
+                m_consume(*instances);
+                m_buffer.release();
+            }
+        }
+
+    public:
+        HeadlessRenderConsumer(RenderExtractionBuffer<Instance> &buffer, std::function<void(const std::vector<Instance>&)> consume)
+            : m_buffer(buffer), m_consume(std::move(consume))
+        {
+            m_thread = std::thread(&HeadlessRenderConsumer::run, this);
+        }
+        ~HeadlessRenderConsumer()
+        {
+            stop();
+        }
+
+        // detiene el pipeline y espera a que el hilo consumidor termine
+        void stop()
+        {
+            m_buffer.stop();
+            if (m_thread.joinable()) m_thread.join();
+        }
+};
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cassert>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "componentPool.hpp"
+#include "types.hpp"
+
+using namespace ecs_types;
+
+using SharedValueIndex = uint32_t; // -> índice compacto a un valor de la tabla compartida
+
+// pool de componentes compartidos: entidades con valores idénticos referencian un único valor
+// deduplicado con conteo de referencias. lecturas pasan por el índice compacto,
+// escrituras se hacen con copy-on-write (modify_component) para no afectar al resto de entidades.
+// NOTE: la deduplicación compara valores (no bytes, que pueden diferir por padding o por 0.0f/-0.0f),
+// por lo que el componente debe definir operator== y una especialización de std::hash<Component>
+// consistente con él (valores iguales => mismo hash)
+template <typename Component>
+class SharedComponentPool final : public IComponentPool
+{
+    private:
+        struct SharedValue
+        {
+            Component value;
+            uint32_t ref_count; // -> número de entidades que referencian el valor (0 => slot libre)
+            size_t hash;
+        };
+
+        ComponentPool<SharedValueIndex> m_entity_values; // -> sparse set: entidad => índice de su valor compartido
+        std::vector<SharedValue> m_values; // -> tabla de valores deduplicados
+        std::vector<SharedValueIndex> m_free_values; // -> índices libres de m_values (se usa como stack)
+        std::unordered_multimap<size_t, SharedValueIndex> m_value_lookup; // -> hash del valor => índices candidatos
+
+        bool m_grouped = true; // -> indica si el vector denso está ordenado por valor compartido
+
+        // se busca el valor en la tabla (o se inserta) y se suma una referencia
+        SharedValueIndex acquire_value(const Component &value)
+        {
+            size_t hash = std::hash<Component>{}(value);
+            auto candidates = m_value_lookup.equal_range(hash);
+            for (auto it = candidates.first; it != candidates.second; it++)
+            {
+                SharedValue &shared = m_values[it->second];
+                if (shared.value == value)
+                {
+                    shared.ref_count++;
+                    return it->second;
+                }
+            }
+
+            SharedValueIndex value_index;
+            if (!m_free_values.empty())
+            {
+                value_index = m_free_values.back();
+                m_free_values.pop_back();
+                m_values[value_index] = {value, 1, hash};
+            }
+            else
+            {
+                value_index = m_values.size();
+                m_values.push_back({value, 1, hash});
+            }
+
+            m_value_lookup.emplace(hash, value_index);
+            return value_index;
+        }
+
+        void release_value(SharedValueIndex value_index)
+        {
+            SharedValue &shared = m_values[value_index];
+            assert(shared.ref_count > 0 && "Valor compartido sin referencias");
+            if (--shared.ref_count > 0) return;
+
+            // sin referencias: se saca del lookup y el slot queda libre para reutilizarse
+            auto candidates = m_value_lookup.equal_range(shared.hash);
+            for (auto it = candidates.first; it != candidates.second; it++)
+            {
+                if (it->second == value_index)
+                {
+                    m_value_lookup.erase(it);
+                    break;
+                }
+            }
+            m_free_values.push_back(value_index);
+        }
+
+    public:
+        SharedComponentPool() = default;
+        ~SharedComponentPool() {};
+
+        // se agrega o reemplaza el valor de la entidad
+        void set_component(EntityId entity_id, const Component &value)
+        {
+            assert(entity_id < MAX_ENTITIES && "Entidad inválida");
+
+            // se adquiere el nuevo valor antes de soltar el anterior (pueden ser el mismo)
+            SharedValueIndex value_index = acquire_value(value);
+            if (m_entity_values.has_component(entity_id))
+            {
+                SharedValueIndex &current_index = m_entity_values.get_component(entity_id);
+                release_value(current_index);
+                if (current_index != value_index) m_grouped = false;
+                current_index = value_index;
+            }
+            else
+            {
+                m_entity_values.add_component(entity_id);
+                m_entity_values.get_component(entity_id) = value_index;
+                m_grouped = false;
+            }
+        }
+
+        // se retorna una copia: insertar un valor nuevo puede realocar la tabla e invalidar referencias
+        Component get_component(EntityId entity_id)
+        {
+            return m_values[m_entity_values.get_component(entity_id)].value;
+        }
+
+        // copy-on-write: modify recibe una copia del valor, que luego se vuelve a deduplicar
+        template <typename Modify>
+        void modify_component(EntityId entity_id, Modify modify)
+        {
+            Component value = get_component(entity_id);
+            modify(value);
+            set_component(entity_id, value);
+        }
+
+        void remove_component(EntityId entity_id) override
+        {
+            assert(entity_id < MAX_ENTITIES && "Entidad inválida");
+            if (!m_entity_values.has_component(entity_id)) return;
+
+            release_value(m_entity_values.get_component(entity_id));
+            m_entity_values.remove_component(entity_id);
+            m_grouped = false; // -> swap-and-pop rompe el orden por valor
+        }
+
+        bool has_component(EntityId entity_id) const
+        {
+            return m_entity_values.has_component(entity_id);
+        }
+
+        SharedValueIndex get_value_index(EntityId entity_id)
+        {
+            return m_entity_values.get_component(entity_id);
+        }
+
+        uint32_t get_unique_value_count() const
+        {
+            return m_values.size() - m_free_values.size();
+        }
+
+        // se recorre cada valor compartido una sola vez junto a sus entidades:
+        // function(const Component &value, const DenseSlot<SharedValueIndex> *slots, size_t count)
+        // NOTE: value y slots apuntan a la tabla y al vector denso, solo son válidos durante la llamada
+        // y function no debe agregar, modificar ni remover componentes de este tipo
+        template <typename Function>
+        void for_each_group(Function function)
+        {
+            std::vector<DenseSlot<SharedValueIndex>> &dense = m_entity_values.get_dense_vector();
+            if (!m_grouped)
+            {
+                // se ordena el vector denso por índice de valor para que cada grupo quede contiguo
+                m_entity_values.sort([](SharedValueIndex a, SharedValueIndex b) { return a < b; });
+                m_grouped = true;
+            }
+
+            size_t group_start = 0;
+            while (group_start < dense.size())
+            {
+                SharedValueIndex value_index = dense[group_start].component;
+                size_t group_end = group_start + 1;
+                while (group_end < dense.size() && dense[group_end].component == value_index) group_end++;
+
+                function(m_values[value_index].value, dense.data() + group_start, group_end - group_start);
+                group_start = group_end;
+            }
+        }
+};
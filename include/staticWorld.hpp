@@ -0,0 +1,285 @@
+#pragma once
+
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "entityManager.hpp"
+#include "componentPool.hpp"
+#include "eventBus.hpp"
+#include "types.hpp"
+
+using namespace ecs_types;
+
+// variante de ECS con conjunto de componentes fijo en compilación:
+// type ids son índices constexpr dentro del pack, los pools viven directamente en una tupla
+// (sin map, sin heap por pool, sin casts ni llamadas virtuales) y destroy_entity se desenrolla en compilación.
+// mantiene la misma API de ECS (add/get/has/remove/get_component_dense_vector) para poder intercambiarlos
+template <typename... Components>
+class StaticWorld
+{
+    private:
+        static_assert(sizeof...(Components) <= MAX_COMPONENTS, "Límite de tipos de componentes alcanzado");
+
+        struct TagPool {}; // -> tags (tipos vacíos) solo viven en la signature
+
+        template <typename Component>
+        using StaticPool = std::conditional_t<std::is_empty_v<Component>, TagPool, ComponentPool<Component>>;
+
+        template <typename Component>
+        static constexpr ComponentTypeId find_component_index()
+        {
+            constexpr bool matches[] = { std::is_same_v<Component, Components>... };
+            for (ComponentTypeId index = 0; index < sizeof...(Components); index++)
+            {
+                if (matches[index]) return index;
+            }
+            return MAX_COMPONENTS; // -> no pertenece al mundo
+        }
+
+        template <typename Component>
+        static constexpr bool contains_component = find_component_index<Component>() < sizeof...(Components);
+
+        EntityManager m_entity_manager;
+        std::tuple<StaticPool<Components>...> m_component_pools; // -> pool de cada componente, indexado por type id
+        EventBus m_event_bus;
+
+        template <typename Component>
+        ComponentPool<Component>& get_pool()
+        {
+            static_assert(contains_component<Component>, "Componente no pertenece a este StaticWorld");
+            static_assert(!std::is_empty_v<Component>, "Tags no tienen pool, se manejan mediante la signature");
+            return std::get<find_component_index<Component>()>(m_component_pools);
+        }
+
+        template <std::size_t... Indices>
+        static constexpr bool has_unique_components(std::index_sequence<Indices...>)
+        {
+            // cada tipo debe encontrarse en su propia posición, si no está repetido
+            return ((find_component_index<Components>() == Indices) && ...);
+        }
+
+        template <std::size_t Index>
+        void remove_component_if_present(EntityId entity_id, const Signature &signature)
+        {
+            using Component = std::tuple_element_t<Index, std::tuple<Components...>>;
+            if constexpr (!std::is_empty_v<Component>)
+            {
+                if (signature.test(Index)) std::get<Index>(m_component_pools).remove_component(entity_id);
+            }
+        }
+
+        template <std::size_t... Indices>
+        void remove_all_components(EntityId entity_id, const Signature &signature, std::index_sequence<Indices...>)
+        {
+            (remove_component_if_present<Indices>(entity_id, signature), ...);
+        }
+
+    public:
+        StaticWorld()
+        {
+            static_assert(has_unique_components(std::index_sequence_for<Components...>{}), "Componentes repetidos en StaticWorld");
+        }
+        ~StaticWorld() {};
+
+        template <typename Component>
+        static constexpr ComponentTypeId get_component_type_id()
+        {
+            static_assert(contains_component<Component>, "Componente no pertenece a este StaticWorld");
+            return find_component_index<Component>();
+        }
+
+        // -- entities --
+        EntityId create_entity()
+        {
+            return m_entity_manager.create_entity();
+        }
+
+        EntityIdCache make_entity_id_cache(uint32_t batch_size = 64)
+        {
+            return EntityIdCache(m_entity_manager, batch_size);
+        }
+
+        bool is_entity_alive(EntityId entity_id)
+        {
+            return m_entity_manager.is_entity_alive(entity_id);
+        }
+
+        uint32_t get_living_entity_count()
+        {
+            return m_entity_manager.get_living_entity_count();
+        }
+
+        void destroy_entity(EntityId entity_id)
+        {
+            assert(entity_id < MAX_ENTITIES && "Entidad no válida");
+            assert(m_entity_manager.is_entity_alive(entity_id) && "Entidad ya destruida previamente");
+
+            // se remueve cada componente cuyo bit esté en 1 (desenrollado sobre el pack)
+            Signature entity_signature = m_entity_manager.get_signature(entity_id);
+            remove_all_components(entity_id, entity_signature, std::index_sequence_for<Components...>{});
+
+            m_entity_manager.destroy_entity(entity_id);
+        }
+
+        // -- components --
+        template <typename Component>
+        void register_component()
+        {
+            // componentes quedan registrados en compilación, se mantiene por compatibilidad con ECS
+            static_assert(contains_component<Component>, "Componente no pertenece a este StaticWorld");
+        }
+
+        template <typename Component>
+        Component& add_component(EntityId entity_id)
+        {
+            constexpr ComponentTypeId type_id = get_component_type_id<Component>();
+
+            if constexpr (std::is_empty_v<Component>)
+            {
+                m_entity_manager.add_component_to_signature(entity_id, type_id);
+
+                static Component tag;
+                return tag;
+            }
+            else
+            {
+                ComponentPool<Component>& pool = get_pool<Component>();
+                pool.add_component(entity_id);
+                m_entity_manager.add_component_to_signature(entity_id, type_id);
+
+                return pool.get_component(entity_id);
+            }
+        }
+
+        template <typename Component>
+        void remove_component(EntityId entity_id)
+        {
+            if constexpr (!std::is_empty_v<Component>)
+            {
+                get_pool<Component>().remove_component(entity_id);
+            }
+
+            m_entity_manager.remove_component_from_signature(entity_id, get_component_type_id<Component>());
+        }
+
+        template <typename Component>
+        Component& get_component(EntityId entity_id)
+        {
+            assert(entity_id < MAX_ENTITIES && "Entidad no válida");
+
+            if constexpr (std::is_empty_v<Component>)
+            {
+                assert(has_component<Component>(entity_id) && "Entidad no tiene este componente");
+                static Component tag;
+                return tag;
+            }
+            else
+            {
+                ComponentPool<Component>& pool = get_pool<Component>();
+                assert(pool.has_component(entity_id) && "Entidad no tiene este componente");
+                return pool.get_component(entity_id);
+            }
+        }
+
+        template <typename Component>
+        bool has_component(EntityId entity_id)
+        {
+            assert(entity_id < MAX_ENTITIES && "Entidad no válida");
+
+            if constexpr (std::is_empty_v<Component>)
+            {
+                return m_entity_manager.get_signature(entity_id).test(get_component_type_id<Component>());
+            }
+            else
+            {
+                return get_pool<Component>().has_component(entity_id);
+            }
+        }
+
+        template <typename Component>
+        std::vector<DenseSlot<Component>>& get_component_dense_vector()
+        {
+            return get_pool<Component>().get_dense_vector();
+        }
+
+        // -- time-slicing --
+        // se procesa una ventana rotativa del pool por llamada, continuando donde quedó la anterior
+        // (ej: fraction = 0.25 => cada entidad se procesa una vez cada 4 llamadas).
+        // function(DenseSlot<Component> &slot) puede remover componentes sin que se salten entidades
+        template <typename Component, typename Function>
+        uint32_t update_sliced(float fraction, Function function)
+        {
+            assert(fraction > 0.0f && fraction <= 1.0f && "Fracción inválida");
+            ComponentPool<Component>& pool = get_pool<Component>();
+            uint32_t window_count = static_cast<uint32_t>(std::ceil(pool.get_slice_size() * fraction));
+            return pool.process_slice(window_count, function);
+        }
+
+        // se procesa desde el cursor hasta agotar el presupuesto de tiempo (al menos una entidad por llamada)
+        template <typename Component, typename Function>
+        uint32_t update_budgeted(std::chrono::microseconds budget, Function function)
+        {
+            ComponentPool<Component>& pool = get_pool<Component>();
+            return pool.process_slice_for(budget, function);
+        }
+
+        // -- queries --
+        template <typename... QueryComponents>
+        Signature get_signature_mask()
+        {
+            Signature mask;
+            (mask.set(get_component_type_id<QueryComponents>()), ...);
+            return mask;
+        }
+
+        void query(const Signature &include, const Signature &exclude, std::vector<EntityId> &out)
+        {
+            m_entity_manager.query(include, exclude, out);
+        }
+
+        // -- events --
+        template <typename Event>
+        void register_event()
+        {
+            m_event_bus.register_event<Event>();
+        }
+
+        // segment identifica al hilo que envía (0 = hilo principal), ver MAX_EVENT_SEGMENTS
+        template <typename Event>
+        void send_event(const Event &event, uint32_t segment = 0)
+        {
+            m_event_bus.send<Event>(event, segment);
+        }
+
+        // function(const Event &event) por cada evento legible en este frame
+        template <typename Event, typename Function>
+        void read_events(Function function)
+        {
+            m_event_bus.get_event_queue<Event>().read(function);
+        }
+
+        // function(const Event *events, size_t count) por cada segmento con eventos
+        template <typename Event, typename Function>
+        void read_event_batches(Function function)
+        {
+            m_event_bus.get_event_queue<Event>().read_batches(function);
+        }
+
+        template <typename Event>
+        EventQueue<Event>& get_event_queue()
+        {
+            return m_event_bus.get_event_queue<Event>();
+        }
+
+        // se intercambian buffers de todas las colas: eventos del frame pasan a ser legibles
+        void update_events()
+        {
+            m_event_bus.update();
+        }
+
+};
@@ -1,18 +1,90 @@
 #pragma once
 
-#include <bitset>
+#include <array>
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
 
+// número máx. de tipos de componentes, configurable en compilación (-DECS_MAX_COMPONENTS=N, múltiplo de 32)
+#ifndef ECS_MAX_COMPONENTS
+#define ECS_MAX_COMPONENTS 64
+#endif
 
 namespace ecs_types
 {
     using EntityId = std::uint32_t;
-    using ComponentTypeId = std::uint8_t;
+    using ComponentTypeId = std::uint16_t;
 
     const EntityId MAX_ENTITIES = 5000; // -> número máx. de entidades que se pueden crear
-    const ComponentTypeId MAX_COMPONENTS = 32; // -> número máx. de tipos de componentes por entidad
+    const ComponentTypeId MAX_COMPONENTS = ECS_MAX_COMPONENTS; // -> número máx. de tipos de componentes por entidad
     const uint32_t INVALID = UINT32_MAX; // -> valor inválido para índices
 
-    using Signature = std::bitset<MAX_COMPONENTS>; // -> signature es una cadena de bits asociada a cada entidad que indica
-                                                   // qué componentes tiene (cada bit representa a un tipo de componente)
+    static_assert(ECS_MAX_COMPONENTS > 0 && ECS_MAX_COMPONENTS % 32 == 0 && ECS_MAX_COMPONENTS <= 1024,
+                  "ECS_MAX_COMPONENTS debe ser múltiplo de 32 (máx. 1024)");
+
+    const uint32_t SIGNATURE_WORDS = MAX_COMPONENTS / 32; // -> palabras de 32 bits por signature
+
+    // signature es una cadena de bits asociada a cada entidad que indica
+    // qué componentes tiene (cada bit representa a un tipo de componente).
+    // se guarda como arreglo plano de palabras para poder compararlas con SIMD
+    struct Signature
+    {
+        std::array<uint32_t, SIGNATURE_WORDS> words = {};
+
+        bool test(size_t position) const
+        {
+            assert(position < MAX_COMPONENTS && "Posición fuera de la signature");
+            return (words[position / 32] >> (position % 32)) & 1u;
+        }
+
+        void set(size_t position, bool value = true)
+        {
+            assert(position < MAX_COMPONENTS && "Posición fuera de la signature");
+            uint32_t bit = 1u << (position % 32);
+            if (value) words[position / 32] |= bit;
+            else words[position / 32] &= ~bit;
+        }
+
+        void reset()
+        {
+            words.fill(0);
+        }
+
+        bool none() const
+        {
+            for (uint32_t word : words)
+            {
+                if (word != 0) return false;
+            }
+            return true;
+        }
+
+        bool any() const
+        {
+            return !none();
+        }
+
+        // true si tiene todos los bits de include y ninguno de exclude
+        bool matches(const Signature &include, const Signature &exclude) const
+        {
+            for (uint32_t word = 0; word < SIGNATURE_WORDS; word++)
+            {
+                if ((words[word] & include.words[word]) != include.words[word]) return false;
+                if ((words[word] & exclude.words[word]) != 0) return false;
+            }
+            return true;
+        }
+
+        bool operator==(const Signature &other) const
+        {
+            return words == other.words;
+        }
+
+        bool operator!=(const Signature &other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    static_assert(sizeof(Signature) == SIGNATURE_WORDS * sizeof(uint32_t), "Signature debe ser contigua (sin padding)");
 }
@@ -2,50 +2,137 @@
 #include "../include/types.hpp"
 #include <sys/types.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+namespace
+{
+    // cabeza de la lista libre empaqueta tag (32 bits altos) e id (32 bits bajos)
+    uint64_t pack_head(uint32_t tag, EntityId entity_id)
+    {
+        return (static_cast<uint64_t>(tag) << 32) | entity_id;
+    }
+
+    uint32_t head_tag(uint64_t head) { return static_cast<uint32_t>(head >> 32); }
+    EntityId head_entity(uint64_t head) { return static_cast<EntityId>(head); }
+}
 
 EntityManager::EntityManager()
+    : m_next_available(new std::atomic<EntityId>[MAX_ENTITIES]),
+      m_alive_entities(new std::atomic<bool>[MAX_ENTITIES])
 {
     for (EntityId entity = 0; entity < MAX_ENTITIES; entity++)
     {   
-        // se inicializan todos los ids de entidades como disponibles
-        m_available_entities.push_back(entity);
+        // se inicializan todos los ids de entidades como disponibles,
+        // enlazados de mayor a menor (el tope de la lista es el último id)
+        m_next_available[entity].store(entity == 0 ? INVALID : entity - 1, std::memory_order_relaxed);
+        m_alive_entities[entity].store(false, std::memory_order_relaxed);
     }
+    m_available_head.store(pack_head(0, MAX_ENTITIES - 1), std::memory_order_release);
     
     m_signatures.resize(MAX_ENTITIES);
-    m_alive_entities.resize(MAX_ENTITIES, false);
 }
 
-EntityId EntityManager::create_entity()
+uint32_t EntityManager::reserve_entity_ids(uint32_t count, EntityId *out)
 {
-    // NOTE: se trata al vector como un stack
-    assert(m_living_entity_count < MAX_ENTITIES && "Límite de entidades alcanzado");
-    assert(!m_available_entities.empty() && "No hay entidades disponibles");
+    uint64_t head = m_available_head.load(std::memory_order_acquire);
+    while (true)
+    {
+        EntityId first_id = head_entity(head);
+        if (first_id == INVALID || count == 0) return 0; // -> no hay entidades disponibles
+
+        // se recorren hasta count nodos desde el tope; si otro hilo cambia la lista
+        // mientras tanto el tag de la cabeza cambia y el CAS falla
+        EntityId last_id = first_id;
+        uint32_t reserved_count = 1;
+        while (reserved_count < count)
+        {
+            EntityId next_id = m_next_available[last_id].load(std::memory_order_relaxed);
+            if (next_id == INVALID) break;
+            last_id = next_id;
+            reserved_count++;
+        }
+
+        EntityId new_top = m_next_available[last_id].load(std::memory_order_relaxed);
+        uint64_t new_head = pack_head(head_tag(head) + 1, new_top);
+        if (m_available_head.compare_exchange_weak(head, new_head, std::memory_order_acquire, std::memory_order_acquire))
+        {
+            // CAS exitoso => el tramo [first_id, last_id] ahora pertenece solo a este hilo
+            EntityId entity_id = first_id;
+            for (uint32_t i = 0; i < reserved_count; i++)
+            {
+                out[i] = entity_id;
+                entity_id = m_next_available[entity_id].load(std::memory_order_relaxed);
+            }
+            return reserved_count;
+        }
+    }
+}
+
+void EntityManager::push_available_entities(EntityId first_id, EntityId last_id)
+{
+    // se apila el tramo ya enlazado [first_id, last_id] sobre la cabeza actual
+    uint64_t head = m_available_head.load(std::memory_order_relaxed);
+    uint64_t new_head;
+    do
+    {
+        m_next_available[last_id].store(head_entity(head), std::memory_order_relaxed);
+        new_head = pack_head(head_tag(head) + 1, first_id);
+    }
+    while (!m_available_head.compare_exchange_weak(head, new_head, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void EntityManager::release_entity_ids(const EntityId *ids, uint32_t count)
+{
+    if (count == 0) return;
+
+    // se enlazan los ids entre sí y se devuelven con un único CAS
+    for (uint32_t i = 0; i + 1 < count; i++)
+    {
+        assert(ids[i] < MAX_ENTITIES && "Entidad inválida");
+        m_next_available[ids[i]].store(ids[i + 1], std::memory_order_relaxed);
+    }
+    push_available_entities(ids[0], ids[count - 1]);
+}
+
+void EntityManager::activate_entity(EntityId entity_id)
+{
+    assert(entity_id < MAX_ENTITIES && "Entidad inválida");
 
-    EntityId entity_id = m_available_entities.back();
-    m_available_entities.pop_back(); // -> se saca la entidad del stack de entidades disponibles
-    m_living_entity_count++;
-    
     m_signatures[entity_id].reset();
-    m_alive_entities[entity_id] = true; // -> se marca la entidad como viva
+    [[maybe_unused]] bool was_alive = m_alive_entities[entity_id].exchange(true, std::memory_order_acq_rel); // -> se marca la entidad como viva
+    assert(!was_alive && "Entidad ya estaba viva");
+    m_living_entity_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+EntityId EntityManager::create_entity()
+{
+    EntityId entity_id = INVALID;
+    [[maybe_unused]] uint32_t reserved_count = reserve_entity_ids(1, &entity_id); // -> se saca la entidad del tope de la lista libre
+    assert(reserved_count == 1 && "Límite de entidades alcanzado");
 
+    activate_entity(entity_id);
     return entity_id;
 }
 
 void EntityManager::destroy_entity(EntityId entity_id)
 {
     assert(entity_id < MAX_ENTITIES && "Entidad inválida");
-    assert(m_alive_entities[entity_id] && "Entidad ya destruida previamente");
+
+    [[maybe_unused]] bool was_alive = m_alive_entities[entity_id].exchange(false, std::memory_order_acq_rel); // -> se marca entidad como muerta
+    assert(was_alive && "Entidad ya destruida previamente");
 
     m_signatures[entity_id].reset(); // -> se resetea firma de componentes de la entidad
-    m_alive_entities[entity_id] = false; // -> se marca entidad como muerta
-    m_available_entities.push_back(entity_id); // -> se devuelve la entidad al stack de disponibles
-    m_living_entity_count--;
+    m_living_entity_count.fetch_sub(1, std::memory_order_relaxed);
+    push_available_entities(entity_id, entity_id); // -> se devuelve la entidad a la lista de disponibles
 }
 
 bool EntityManager::is_entity_alive(EntityId entity_id) const
 {
     assert(entity_id < MAX_ENTITIES && "Entidad inválida");
-    return m_alive_entities[entity_id];
+    return m_alive_entities[entity_id].load(std::memory_order_acquire);
 }
 
 void EntityManager::set_signature(EntityId entity_id, Signature signature)
@@ -79,9 +166,86 @@ void EntityManager::remove_component_from_signature(EntityId entity_id, Componen
     m_signatures[entity_id].set(type_id, false);
 }
 
+void EntityManager::query(const Signature &include, const Signature &exclude, std::vector<EntityId> &out) const
+{
+    out.clear();
+    EntityId entity_id = 0;
+
+#if defined(__SSE2__)
+    [[maybe_unused]] const __m128i zero = _mm_setzero_si128();
+
+    if constexpr (4 % SIGNATURE_WORDS == 0)
+    {
+        // signatures son contiguas en m_signatures => un registro de 128 bits contiene
+        // (4 / SIGNATURE_WORDS) entidades, se comparan todas de una vez
+        constexpr uint32_t ENTITIES_PER_VECTOR = 4 / SIGNATURE_WORDS;
+        constexpr int ENTITY_LANES = SIGNATURE_WORDS < 4 ? (1 << SIGNATURE_WORDS) - 1 : 0xF;
+
+        alignas(16) uint32_t include_lanes[4];
+        alignas(16) uint32_t exclude_lanes[4];
+        for (uint32_t lane = 0; lane < 4; lane++)
+        {
+            // se repiten las máscaras para cada entidad dentro del registro
+            include_lanes[lane] = include.words[lane % SIGNATURE_WORDS];
+            exclude_lanes[lane] = exclude.words[lane % SIGNATURE_WORDS];
+        }
+        const __m128i include_mask = _mm_load_si128(reinterpret_cast<const __m128i*>(include_lanes));
+        const __m128i exclude_mask = _mm_load_si128(reinterpret_cast<const __m128i*>(exclude_lanes));
+
+        for (; entity_id + ENTITIES_PER_VECTOR <= MAX_ENTITIES; entity_id += ENTITIES_PER_VECTOR)
+        {
+            __m128i signatures = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_signatures[entity_id].words.data()));
+            __m128i has_include = _mm_cmpeq_epi32(_mm_and_si128(signatures, include_mask), include_mask);
+            __m128i has_no_exclude = _mm_cmpeq_epi32(_mm_and_si128(signatures, exclude_mask), zero);
+
+            // un bit por palabra de 32 bits, la entidad calza si todas sus palabras calzan
+            int lanes = _mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(has_include, has_no_exclude)));
+            if (lanes == 0) continue;
+
+            for (uint32_t offset = 0; offset < ENTITIES_PER_VECTOR; offset++)
+            {
+                bool match = ((lanes >> (offset * SIGNATURE_WORDS)) & ENTITY_LANES) == ENTITY_LANES;
+                if (match && m_alive_entities[entity_id + offset].load(std::memory_order_relaxed)) out.push_back(entity_id + offset);
+            }
+        }
+    }
+    else if constexpr (SIGNATURE_WORDS % 4 == 0)
+    {
+        // signatures anchas: se compara cada entidad en bloques de 4 palabras
+        for (; entity_id < MAX_ENTITIES; entity_id++)
+        {
+            if (!m_alive_entities[entity_id].load(std::memory_order_relaxed)) continue;
+
+            const uint32_t *signature_words = m_signatures[entity_id].words.data();
+            bool match = true;
+            for (uint32_t word = 0; word < SIGNATURE_WORDS && match; word += 4)
+            {
+                __m128i signatures = _mm_loadu_si128(reinterpret_cast<const __m128i*>(signature_words + word));
+                __m128i include_mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(include.words.data() + word));
+                __m128i exclude_mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(exclude.words.data() + word));
+                __m128i has_include = _mm_cmpeq_epi32(_mm_and_si128(signatures, include_mask), include_mask);
+                __m128i has_no_exclude = _mm_cmpeq_epi32(_mm_and_si128(signatures, exclude_mask), zero);
+                match = _mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(has_include, has_no_exclude))) == 0xF;
+            }
+
+            if (match) out.push_back(entity_id);
+        }
+    }
+#endif
+
+    // resto de entidades (o todas si no hay SSE2) se revisan de forma escalar
+    for (; entity_id < MAX_ENTITIES; entity_id++)
+    {
+        if (m_alive_entities[entity_id].load(std::memory_order_relaxed) && m_signatures[entity_id].matches(include, exclude))
+        {
+            out.push_back(entity_id);
+        }
+    }
+}
+
 uint32_t EntityManager::get_living_entity_count() const
 {
-    return m_living_entity_count; // -> se retorn num. entidades vivas
+    return m_living_entity_count.load(std::memory_order_relaxed); // -> se retorn num. entidades vivas
 }
 
 